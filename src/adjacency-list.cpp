@@ -28,6 +28,32 @@ namespace nlsr {
 
 INIT_LOGGER(AdjacencyList);
 
+AdjacencyList::AdjacencyList(const AdjacencyList& other)
+  : m_adjList(other.m_adjList)
+{
+  rebuildIndex();
+}
+
+AdjacencyList&
+AdjacencyList::operator=(const AdjacencyList& other)
+{
+  if (this != &other) {
+    m_index.clear();
+    m_adjList = other.m_adjList;
+    rebuildIndex();
+  }
+  return *this;
+}
+
+void
+AdjacencyList::rebuildIndex()
+{
+  m_index.clear();
+  for (auto it = m_adjList.begin(); it != m_adjList.end(); ++it) {
+    m_index.insert(it);
+  }
+}
+
 bool
 AdjacencyList::insert(const Adjacent& adjacent)
 {
@@ -35,7 +61,7 @@ AdjacencyList::insert(const Adjacent& adjacent)
   if (it != m_adjList.end()) {
     return false;
   }
-  m_adjList.push_back(adjacent);
+  m_index.insert(m_adjList.insert(m_adjList.end(), adjacent));
   return true;
 }
 
@@ -177,57 +203,61 @@ AdjacencyList::getNumOfActiveNeighbor() const
 std::list<Adjacent>::iterator
 AdjacencyList::find(const ndn::Name& adjName)
 {
-  return std::find_if(m_adjList.begin(),
-                      m_adjList.end(),
-                      std::bind(&Adjacent::compare, _1, std::cref(adjName)));
+  const auto& byNameIndex = m_index.get<byName>();
+  auto it = byNameIndex.find(adjName);
+  return it != byNameIndex.end() ? *it : m_adjList.end();
 }
 
 std::list<Adjacent>::const_iterator
 AdjacencyList::find(const ndn::Name& adjName) const
 {
-  return std::find_if(m_adjList.cbegin(),
-                      m_adjList.cend(),
-                      std::bind(&Adjacent::compare, _1, std::cref(adjName)));
+  const auto& byNameIndex = m_index.get<byName>();
+  auto it = byNameIndex.find(adjName);
+  return it != byNameIndex.end() ? const_iterator(*it) : m_adjList.cend();
 }
 
 AdjacencyList::iterator
 AdjacencyList::findAdjacent(const ndn::Name& adjName)
 {
-  return std::find_if(m_adjList.begin(),
-                      m_adjList.end(),
-                      std::bind(&Adjacent::compare,
-                                _1, std::cref(adjName)));
+  return find(adjName);
 }
 
 AdjacencyList::iterator
 AdjacencyList::findAdjacent(uint64_t faceId)
 {
-  return std::find_if(m_adjList.begin(),
-                      m_adjList.end(),
-                      std::bind(&Adjacent::compareFaceId,
-                                _1, faceId));
+  const auto& byFaceIdIndex = m_index.get<byFaceId>();
+  auto it = byFaceIdIndex.find(faceId);
+  return it != byFaceIdIndex.end() ? *it : m_adjList.end();
 }
 
 AdjacencyList::iterator
 AdjacencyList::findAdjacent(const ndn::FaceUri& faceUri)
 {
-  return std::find_if(m_adjList.begin(),
-                      m_adjList.end(),
-                      std::bind(&Adjacent::compareFaceUri,
-                                _1, faceUri));
+  const auto& byFaceUriIndex = m_index.get<byFaceUri>();
+  auto it = byFaceUriIndex.find(faceUri.toString());
+  return it != byFaceUriIndex.end() ? *it : m_adjList.end();
 }
 
 uint64_t
 AdjacencyList::getFaceId(const ndn::FaceUri& faceUri)
 {
-  std::list<Adjacent>::iterator it = std::find_if(m_adjList.begin(),
-                                                  m_adjList.end(),
-                                                  std::bind(&Adjacent::compareFaceUri,
-                                                            _1, faceUri));
-
+  auto it = findAdjacent(faceUri);
   return it != m_adjList.end() ? it->getFaceId() : 0;
 }
 
+void
+AdjacencyList::setFaceId(iterator it, uint64_t faceId)
+{
+  auto& byNameIndex = m_index.get<byName>();
+  auto pos = byNameIndex.find(it->getName());
+  if (pos == byNameIndex.end()) {
+    it->setFaceId(faceId);
+    return;
+  }
+  // modify() rehashes the entry once the Face ID has changed
+  byNameIndex.modify(pos, [faceId] (iterator& adj) { adj->setFaceId(faceId); });
+}
+
 void
 AdjacencyList::writeLog()
 {
@@ -27,17 +27,39 @@
 
 #include <list>
 
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/tag.hpp>
+
 namespace nlsr {
 
+/*! \brief The configured neighbors of this router.
+ *
+ * The adjacencies are kept in a std::list, in insertion order, and indexed
+ * by name, Face ID and FaceUri through hashed indices over the list
+ * iterators, so lookups do not scan the list.
+ */
 class AdjacencyList
 {
 public:
   typedef std::list<Adjacent>::const_iterator const_iterator;
   typedef std::list<Adjacent>::iterator iterator;
 
+  AdjacencyList() = default;
+
+  AdjacencyList(const AdjacencyList& other);
+
+  AdjacencyList&
+  operator=(const AdjacencyList& other);
+
   bool
   insert(const Adjacent& adjacent);
 
+  /*! \brief Returns the adjacencies in insertion order.
+
+    The name, Face ID and FaceUri of an adjacency are indexed and must not
+    be changed through this list; use setFaceId() instead.
+   */
   std::list<Adjacent>&
   getAdjList();
 
@@ -98,6 +120,7 @@ public:
   void
   reset()
   {
+    m_index.clear();
     m_adjList.clear();
   }
 
@@ -126,6 +149,11 @@ public:
   uint64_t
   getFaceId(const ndn::FaceUri& faceUri);
 
+  /*! \brief Sets the Face ID of the adjacency at \p it and updates the index.
+   */
+  void
+  setFaceId(iterator it, uint64_t faceId);
+
   void
   writeLog();
 
@@ -149,8 +177,59 @@ private:
   const_iterator
   find(const ndn::Name& adjName) const;
 
+  void
+  rebuildIndex();
+
 private:
+  struct NameKey
+  {
+    using result_type = ndn::Name;
+
+    const ndn::Name&
+    operator()(const iterator& it) const
+    {
+      return it->getName();
+    }
+  };
+
+  struct FaceIdKey
+  {
+    using result_type = uint64_t;
+
+    uint64_t
+    operator()(const iterator& it) const
+    {
+      return it->getFaceId();
+    }
+  };
+
+  struct FaceUriKey
+  {
+    using result_type = std::string;
+
+    std::string
+    operator()(const iterator& it) const
+    {
+      return it->getFaceUri().toString();
+    }
+  };
+
+  struct byName {};
+  struct byFaceId {};
+  struct byFaceUri {};
+
+  using Index = boost::multi_index_container<
+    iterator,
+    boost::multi_index::indexed_by<
+      boost::multi_index::hashed_unique<boost::multi_index::tag<byName>,
+                                        NameKey, std::hash<ndn::Name>>,
+      boost::multi_index::hashed_non_unique<boost::multi_index::tag<byFaceId>, FaceIdKey>,
+      boost::multi_index::hashed_non_unique<boost::multi_index::tag<byFaceUri>, FaceUriKey>
+    >
+  >;
+
   std::list<Adjacent> m_adjList;
+  Index m_index;
 };
 
 } // namespace nlsr
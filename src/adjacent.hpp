@@ -141,6 +141,39 @@ public:
     return m_faceId;
   }
 
+  /*! \brief Current interval between two hello Interests to this neighbor.
+   *
+   * Zero until HelloProtocol has started sending hellos to the neighbor.
+   * The interval is local state and is not part of the wire encoding.
+   */
+  ndn::time::seconds
+  getHelloInterval() const
+  {
+    return m_helloInterval;
+  }
+
+  void
+  setHelloInterval(ndn::time::seconds interval)
+  {
+    m_helloInterval = interval;
+  }
+
+  /*! \brief Smoothed RTT of hello Interests to this neighbor, zero until measured.
+   *
+   * Like the hello interval, this is local state and is not encoded.
+   */
+  ndn::time::nanoseconds
+  getSmoothedRtt() const
+  {
+    return m_smoothedRtt;
+  }
+
+  void
+  setSmoothedRtt(ndn::time::nanoseconds rtt)
+  {
+    m_smoothedRtt = rtt;
+  }
+
   /*! \brief Equality is when name, Face URI, and link cost are all equal. */
   bool
   operator==(const Adjacent& adjacent) const;
@@ -200,6 +233,10 @@ private:
   /*! m_faceId The NFD-assigned ID for the neighbor, used to
    * determine whether a Face is available */
   uint64_t m_faceId;
+  /*! m_helloInterval The adaptive interval between hellos to the neighbor */
+  ndn::time::seconds m_helloInterval = ndn::time::seconds::zero();
+  /*! m_smoothedRtt The EWMA of the hello RTT to the neighbor */
+  ndn::time::nanoseconds m_smoothedRtt = ndn::time::nanoseconds::zero();
 
   mutable ndn::Block m_wire;
 
@@ -24,7 +24,6 @@
 #include "conf-parameter.hpp"
 #include "lsa/lsa.hpp"
 #include "logger.hpp"
-#include "utility/name-helper.hpp"
 
 #include <boost/lexical_cast.hpp>
 
@@ -41,7 +40,9 @@ SyncLogicHandler::SyncLogicHandler(ndn::Face& face, const IsLsaNew& isLsaNew,
   , m_nameLsaUserPrefix(ndn::Name(m_confParam.getSyncUserPrefix()).append(boost::lexical_cast<std::string>(Lsa::Type::NAME)))
   , m_syncLogic(m_syncFace, m_confParam.getSyncProtocol(), m_confParam.getSyncPrefix(),
                 m_nameLsaUserPrefix, m_confParam.getSyncInterestLifetime(),
-                std::bind(&SyncLogicHandler::processUpdate, this, _1, _2))
+                std::bind(&SyncLogicHandler::processUpdate, this, _1, _2),
+                m_confParam.getSyncIbfSize())
+  , m_lsaNameLayout(m_confParam.getLsaPrefix(), m_confParam.getNetwork())
 {
   if (m_confParam.getMidstState() == MIDST_STATE_OFF) {
     m_adjLsaUserPrefix = ndn::Name(m_confParam.getSyncUserPrefix())
@@ -64,21 +65,17 @@ SyncLogicHandler::processUpdate(const ndn::Name& updateName, uint64_t highSeq)
 {
   NLSR_LOG_DEBUG("Update Name: " << updateName << " Seq no: " << highSeq);
 
-  int32_t nlsrPosition = util::getNameComponentPosition(updateName, NLSR_COMPONENT);
-  int32_t lsaPosition = util::getNameComponentPosition(updateName, LSA_COMPONENT);
-
-  if (nlsrPosition < 0 || lsaPosition < 0) {
+  if (!m_lsaNameLayout.matches(updateName, 0)) {
     NLSR_LOG_WARN("Received malformed sync update");
     return;
   }
 
-  ndn::Name networkName = updateName.getSubName(1, nlsrPosition-1);
-  ndn::Name routerName = updateName.getSubName(lsaPosition + 1).getPrefix(-1);
-
-  ndn::Name originRouter = networkName;
-  originRouter.append(routerName);
+  // A router should not try to fetch its own LSA
+  if (m_lsaNameLayout.isFromRouter(updateName, 0, m_confParam.getRouterPrefix())) {
+    return;
+  }
 
-  processUpdateFromSync(originRouter, updateName, highSeq);
+  processUpdateFromSync(m_lsaNameLayout.getOriginRouter(updateName, 0), updateName, highSeq);
 }
 
 void
@@ -90,8 +87,7 @@ SyncLogicHandler::processUpdateFromSync(const ndn::Name& originRouter,
   // A router should not try to fetch its own LSA
   if (originRouter != m_confParam.getRouterPrefix()) {
 
-    Lsa::Type lsaType;
-    std::istringstream(updateName.get(updateName.size()-1).toUri()) >> lsaType;
+    Lsa::Type lsaType = getLsaTypeFromNameComponent(updateName[-1]);
 
     NLSR_LOG_DEBUG("Received sync update with higher " << lsaType <<
                    " sequence number than entry in LSDB");
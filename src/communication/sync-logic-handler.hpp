@@ -27,6 +27,7 @@
 #include "signals.hpp"
 #include "lsa/lsa.hpp"
 #include "sync-protocol-adapter.hpp"
+#include "utility/name-helper.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/util/signal.hpp>
@@ -69,6 +70,12 @@ public:
   void
   publishRoutingUpdate(const Lsa::Type& type, const uint64_t& seqNo);
 
+  SyncProtocolAdapter&
+  getSyncProtocolAdapter()
+  {
+    return m_syncLogic;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /*! \brief Callback from Sync protocol
    *
@@ -107,8 +114,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   SyncProtocolAdapter m_syncLogic;
 
 private:
-  const std::string NLSR_COMPONENT = "nlsr";
-  const std::string LSA_COMPONENT = "LSA";
+  const util::LsaNameLayout m_lsaNameLayout;
 };
 
 } // namespace nlsr
@@ -33,9 +33,11 @@ SyncProtocolAdapter::SyncProtocolAdapter(ndn::Face& face,
                                          const ndn::Name& syncPrefix,
                                          const ndn::Name& userPrefix,
                                          ndn::time::milliseconds syncInterestLifetime,
-                                         const SyncUpdateCallback& syncUpdateCallback)
+                                         const SyncUpdateCallback& syncUpdateCallback,
+                                         uint32_t ibfSize)
  : m_syncProtocol(syncProtocol)
  , m_syncUpdateCallback(syncUpdateCallback)
+ , m_ibfSize(ibfSize)
 {
   NLSR_LOG_TRACE("SyncProtocol value: " << m_syncProtocol);
 
@@ -59,13 +61,14 @@ SyncProtocolAdapter::SyncProtocolAdapter(ndn::Face& face,
   }
 #endif
 
-  NDN_LOG_DEBUG("Using PSync");
-  m_psyncLogic = std::make_shared<psync::FullProducer>(80,
+  NDN_LOG_DEBUG("Using PSync with an IBF for " << m_ibfSize << " entries");
+  m_psyncLogic = std::make_shared<psync::FullProducer>(m_ibfSize,
                    face,
                    syncPrefix,
                    userPrefix,
                    std::bind(&SyncProtocolAdapter::onPSyncUpdate, this, _1),
                    syncInterestLifetime);
+  m_nOwnUserNodes = 1;
 }
 
 void
@@ -78,7 +81,10 @@ SyncProtocolAdapter::addUserNode(const ndn::Name& userPrefix)
   }
 #endif
 
-  m_psyncLogic->addUserNode(userPrefix);
+  if (m_psyncLogic->addUserNode(userPrefix)) {
+    ++m_nOwnUserNodes;
+    checkIbfSize();
+  }
 }
 
 void
@@ -112,8 +118,35 @@ SyncProtocolAdapter::onPSyncUpdate(const std::vector<psync::MissingDataInfo>& up
   NLSR_LOG_TRACE("Received PSync update event");
 
   for (const auto& update : updates) {
+    syncIncrementSignal(Statistics::PacketType::RCV_SYNC_UPDATE);
+
+    m_remoteUserNodes.insert(update.prefix);
+
+    // Several sequence numbers learned at once: the node published faster
+    // than sync rounds completed, and only the latest LSA will be fetched
+    if (update.highSeq > update.lowSeq) {
+      NLSR_LOG_DEBUG("Updates " << update.lowSeq << "-" << update.highSeq <<
+                     " of " << update.prefix << " arrived together");
+      syncIncrementSignal(Statistics::PacketType::SYNC_UPDATE_COALESCED);
+    }
+
     m_syncUpdateCallback(update.prefix, update.highSeq);
   }
+
+  checkIbfSize();
+}
+
+void
+SyncProtocolAdapter::checkIbfSize()
+{
+  size_t nUserNodes = m_nOwnUserNodes + m_remoteUserNodes.size();
+  if (m_hasWarnedIbfSize || nUserNodes <= m_ibfSize) {
+    return;
+  }
+
+  NLSR_LOG_WARN("The PSync IBF is sized for " << m_ibfSize << " entries but " << nUserNodes <<
+                " user nodes are known; raise sync-ibf-size on all routers");
+  m_hasWarnedIbfSize = true;
 }
 
 } // namespace nlsr
\ No newline at end of file
@@ -23,13 +23,17 @@
 #define NLSR_SYNC_PROTOCOL_ADAPTER_HPP
 
 #include "conf-parameter.hpp"
+#include "statistics.hpp"
 
 #include <ndn-cxx/face.hpp>
+#include <ndn-cxx/util/signal.hpp>
 #ifdef HAVE_CHRONOSYNC
 #include <ChronoSync/logic.hpp>
 #endif
 #include <PSync/full-producer.hpp>
 
+#include <unordered_set>
+
 namespace nlsr {
 
 typedef std::function<void(const ndn::Name& updateName,
@@ -38,12 +42,17 @@ typedef std::function<void(const ndn::Name& updateName,
 class SyncProtocolAdapter
 {
 public:
+  /*!
+   * \param ibfSize Number of entries the PSync IBF is sized for; it must be the
+   *                same on all routers of the sync group
+   */
   SyncProtocolAdapter(ndn::Face& facePtr,
                       SyncProtocol syncProtocol,
                       const ndn::Name& syncPrefix,
                       const ndn::Name& userPrefix,
                       ndn::time::milliseconds syncInterestLifetime,
-                      const SyncUpdateCallback& syncUpdateCallback);
+                      const SyncUpdateCallback& syncUpdateCallback,
+                      uint32_t ibfSize = SYNC_IBF_SIZE_DEFAULT);
 
   /*! \brief Add user node to ChronoSync or PSync
    *
@@ -63,6 +72,14 @@ public:
   void
   publishUpdate(const ndn::Name& userPrefix, uint64_t seq);
 
+  /*! \brief Returns the number of entries the PSync IBF is sized for.
+   */
+  uint32_t
+  getIbfSize() const
+  {
+    return m_ibfSize;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 #ifdef HAVE_CHRONOSYNC
    /*! \brief Hook function to call whenever ChronoSync detects new data.
@@ -88,6 +105,19 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   onPSyncUpdate(const std::vector<psync::MissingDataInfo>& updates);
 
+private:
+  /*! \brief Warns once when more user nodes are known than the IBF is sized for.
+   *
+   * The IBF is not resized here: PSync drops IBFs whose size differs from
+   * its own, so a router growing on its own would stop syncing with the
+   * others. The size has to be raised in the configuration of all routers.
+   */
+  void
+  checkIbfSize();
+
+public:
+  ndn::util::signal::Signal<SyncProtocolAdapter, Statistics::PacketType> syncIncrementSignal;
+
 private:
   SyncProtocol m_syncProtocol;
   SyncUpdateCallback m_syncUpdateCallback;
@@ -95,6 +125,13 @@ private:
   std::shared_ptr<chronosync::Logic> m_chronoSyncLogic;
 #endif
   std::shared_ptr<psync::FullProducer> m_psyncLogic;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  uint32_t m_ibfSize;
+  size_t m_nOwnUserNodes = 0;
+  /*! User nodes of other routers seen in sync updates */
+  std::unordered_set<ndn::Name> m_remoteUserNodes;
+  bool m_hasWarnedIbfSize = false;
 };
 
 } // namespace nlsr
@@ -331,6 +331,40 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     return false;
   }
 
+  // sync-ibf-size
+  ConfigurationVariable<uint32_t> syncIbfSize("sync-ibf-size",
+                                              std::bind(&ConfParameter::setSyncIbfSize,
+                                                        &m_confParam, _1));
+  syncIbfSize.setMinAndMaxValue(SYNC_IBF_SIZE_MIN, SYNC_IBF_SIZE_MAX);
+  syncIbfSize.setOptional(SYNC_IBF_SIZE_DEFAULT);
+
+  if (!syncIbfSize.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsa-segment-storage-capacity
+  ConfigurationVariable<uint32_t> lsaSegmentStorageCapacity("lsa-segment-storage-capacity",
+                                                            std::bind(&ConfParameter::setLsaSegmentStorageCapacity,
+                                                                      &m_confParam, _1));
+  lsaSegmentStorageCapacity.setMinAndMaxValue(LSA_SEGMENT_STORAGE_CAPACITY_MIN,
+                                              LSA_SEGMENT_STORAGE_CAPACITY_MAX);
+  lsaSegmentStorageCapacity.setOptional(LSA_SEGMENT_STORAGE_CAPACITY_DEFAULT);
+
+  if (!lsaSegmentStorageCapacity.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsdb-snapshot-interval
+  ConfigurationVariable<uint32_t> lsdbSnapshotInterval("lsdb-snapshot-interval",
+                                                       std::bind(&ConfParameter::setLsdbSnapshotInterval,
+                                                                 &m_confParam, _1));
+  lsdbSnapshotInterval.setMinAndMaxValue(LSDB_SNAPSHOT_INTERVAL_MIN, LSDB_SNAPSHOT_INTERVAL_MAX);
+  lsdbSnapshotInterval.setOptional(LSDB_SNAPSHOT_INTERVAL_DEFAULT);
+
+  if (!lsdbSnapshotInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
   try {
     std::string stateDir = section.get<std::string>("state-dir");
     if (bf::exists(stateDir)) {
@@ -434,6 +468,77 @@ ConfFileProcessor::processConfSectionNeighbors(const ConfigSection& section)
     return false;
   }
 
+  // hello-interval-max
+  ConfigurationVariable<uint32_t> helloIntervalMax("hello-interval-max",
+                                                   std::bind(&ConfParameter::setHelloIntervalMax,
+                                                             &m_confParam, _1));
+  helloIntervalMax.setMinAndMaxValue(HELLO_INTERVAL_MAX_MIN, HELLO_INTERVAL_MAX_MAX);
+  helloIntervalMax.setOptional(HELLO_INTERVAL_MAX_DEFAULT);
+
+  if (!helloIntervalMax.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // link-cost-from-rtt
+  std::string rttLinkCost = section.get<std::string>("link-cost-from-rtt", "off");
+
+  if (boost::iequals(rttLinkCost, "on")) {
+    m_confParam.setRttLinkCost(true);
+  }
+  else if (boost::iequals(rttLinkCost, "off")) {
+    m_confParam.setRttLinkCost(false);
+  }
+  else {
+    std::cerr << "Wrong format for link-cost-from-rtt." << std::endl;
+    std::cerr << "Allowed value: on, off" << std::endl;
+
+    return false;
+  }
+
+  // rtt-cost-quantum
+  ConfigurationVariable<uint32_t> rttCostQuantum("rtt-cost-quantum",
+                                                 std::bind(&ConfParameter::setRttCostQuantum,
+                                                           &m_confParam, _1));
+  rttCostQuantum.setMinAndMaxValue(RTT_COST_QUANTUM_MIN, RTT_COST_QUANTUM_MAX);
+  rttCostQuantum.setOptional(RTT_COST_QUANTUM_DEFAULT);
+
+  if (!rttCostQuantum.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // rtt-cost-hysteresis
+  ConfigurationVariable<uint32_t> rttCostHysteresis("rtt-cost-hysteresis",
+                                                    std::bind(&ConfParameter::setRttCostHysteresis,
+                                                              &m_confParam, _1));
+  rttCostHysteresis.setMinAndMaxValue(RTT_COST_HYSTERESIS_MIN, RTT_COST_HYSTERESIS_MAX);
+  rttCostHysteresis.setOptional(RTT_COST_HYSTERESIS_DEFAULT);
+
+  if (!rttCostHysteresis.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // probe-interval
+  ConfigurationVariable<uint32_t> probeInterval("probe-interval",
+                                                std::bind(&ConfParameter::setProbeInterval,
+                                                          &m_confParam, _1));
+  probeInterval.setMinAndMaxValue(PROBE_INTERVAL_MIN, PROBE_INTERVAL_MAX);
+  probeInterval.setOptional(PROBE_INTERVAL_DEFAULT);
+
+  if (!probeInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // probe-detect-multiplier
+  ConfigurationVariable<uint32_t> probeDetectMultiplier("probe-detect-multiplier",
+                                                        std::bind(&ConfParameter::setProbeDetectMultiplier,
+                                                                  &m_confParam, _1));
+  probeDetectMultiplier.setMinAndMaxValue(PROBE_DETECT_MULTIPLIER_MIN, PROBE_DETECT_MULTIPLIER_MAX);
+  probeDetectMultiplier.setOptional(PROBE_DETECT_MULTIPLIER_DEFAULT);
+
+  if (!probeDetectMultiplier.parseFromConfigSection(section)) {
+    return false;
+  }
+
   // Event intervals
   // adj-lsa-build-interval
   ConfigurationVariable<uint32_t> adjLsaBuildInterval("adj-lsa-build-interval",
@@ -445,6 +550,31 @@ ConfFileProcessor::processConfSectionNeighbors(const ConfigSection& section)
   if (!adjLsaBuildInterval.parseFromConfigSection(section)) {
     return false;
   }
+
+  // adj-lsa-build-initial-delay
+  ConfigurationVariable<uint32_t> adjLsaBuildInitialDelay("adj-lsa-build-initial-delay",
+                                                          std::bind(&ConfParameter::setAdjLsaBuildInitialDelay,
+                                                                    &m_confParam, _1));
+  adjLsaBuildInitialDelay.setMinAndMaxValue(ADJ_LSA_BUILD_INITIAL_DELAY_MIN,
+                                            ADJ_LSA_BUILD_INITIAL_DELAY_MAX);
+  adjLsaBuildInitialDelay.setOptional(ADJ_LSA_BUILD_INITIAL_DELAY_DEFAULT);
+
+  if (!adjLsaBuildInitialDelay.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // adj-lsa-build-max-interval
+  ConfigurationVariable<uint32_t> adjLsaBuildMaxInterval("adj-lsa-build-max-interval",
+                                                         std::bind(&ConfParameter::setAdjLsaBuildMaxInterval,
+                                                                   &m_confParam, _1));
+  adjLsaBuildMaxInterval.setMinAndMaxValue(ADJ_LSA_BUILD_MAX_INTERVAL_MIN,
+                                           ADJ_LSA_BUILD_MAX_INTERVAL_MAX);
+  adjLsaBuildMaxInterval.setOptional(ADJ_LSA_BUILD_MAX_INTERVAL_DEFAULT);
+
+  if (!adjLsaBuildMaxInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
   // Set the retry count for fetching the FaceStatus dataset
   ConfigurationVariable<uint32_t> faceDatasetFetchTries("face-dataset-fetch-tries",
                                                         std::bind(&ConfParameter::setFaceDatasetFetchTries,
@@ -606,6 +736,44 @@ ConfFileProcessor::processConfSectionMidst(const ConfigSection& section)
   double hopDist = section.get<int>("set-hop-distance", HOP_DISTANCE_DEFAULT);
   m_confParam.setHopDistance(hopDist);
 
+  // incremental-dv
+  std::string incrementalDv = section.get<std::string>("incremental-dv", "off");
+
+  if (boost::iequals(incrementalDv, "on")) {
+    m_confParam.setIncrementalDv(true);
+  }
+  else if (boost::iequals(incrementalDv, "off")) {
+    m_confParam.setIncrementalDv(false);
+  }
+  else {
+    std::cerr << "Wrong format for incremental-dv." << std::endl;
+    std::cerr << "Allowed value: on, off" << std::endl;
+
+    return false;
+  }
+
+  // dv-update-min-interval
+  ConfigurationVariable<uint32_t> dvUpdateMinInterval("dv-update-min-interval",
+                                                      std::bind(&ConfParameter::setDvUpdateMinInterval,
+                                                                &m_confParam, _1));
+  dvUpdateMinInterval.setMinAndMaxValue(DV_UPDATE_MIN_INTERVAL_MIN, DV_UPDATE_MIN_INTERVAL_MAX);
+  dvUpdateMinInterval.setOptional(DV_UPDATE_MIN_INTERVAL_DEFAULT);
+
+  if (!dvUpdateMinInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // dv-update-max-hold-down
+  ConfigurationVariable<uint32_t> dvUpdateMaxHoldDown("dv-update-max-hold-down",
+                                                      std::bind(&ConfParameter::setDvUpdateMaxHoldDown,
+                                                                &m_confParam, _1));
+  dvUpdateMaxHoldDown.setMinAndMaxValue(DV_UPDATE_MAX_HOLD_DOWN_MIN, DV_UPDATE_MAX_HOLD_DOWN_MAX);
+  dvUpdateMaxHoldDown.setOptional(DV_UPDATE_MAX_HOLD_DOWN_DEFAULT);
+
+  if (!dvUpdateMaxHoldDown.parseFromConfigSection(section)) {
+    return false;
+  }
+
   // Variables and instructions specific to MIDST are processed here.
   for (ConfigSection::const_iterator tn =
        section.begin(); tn != section.end(); ++tn) {
@@ -675,6 +843,30 @@ ConfFileProcessor::processConfSectionFib(const ConfigSection& section)
     return false;
   }
 
+  // routing-calc-initial-delay
+  ConfigurationVariable<uint32_t> routingCalcInitialDelay("routing-calc-initial-delay",
+                                                          std::bind(&ConfParameter::setRoutingCalcInitialDelay,
+                                                                    &m_confParam, _1));
+  routingCalcInitialDelay.setMinAndMaxValue(ROUTING_CALC_INITIAL_DELAY_MIN,
+                                            ROUTING_CALC_INITIAL_DELAY_MAX);
+  routingCalcInitialDelay.setOptional(ROUTING_CALC_INITIAL_DELAY_DEFAULT);
+
+  if (!routingCalcInitialDelay.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-max-interval
+  ConfigurationVariable<uint32_t> routingCalcMaxInterval("routing-calc-max-interval",
+                                                         std::bind(&ConfParameter::setRoutingCalcMaxInterval,
+                                                                   &m_confParam, _1));
+  routingCalcMaxInterval.setMinAndMaxValue(ROUTING_CALC_MAX_INTERVAL_MIN,
+                                           ROUTING_CALC_MAX_INTERVAL_MAX);
+  routingCalcMaxInterval.setOptional(ROUTING_CALC_MAX_INTERVAL_DEFAULT);
+
+  if (!routingCalcMaxInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
   return true;
 }
 
@@ -713,6 +905,8 @@ ConfFileProcessor::processConfSectionSecurity(const ConfigSection& section)
   }
 
   m_confParam.getValidator().load(it->second, m_confFileName);
+  // Keys cached under the previous trust schema may not be trusted by the new one
+  m_confParam.getVerifiedKeyCache().clear();
 
   it++;
   if (it != section.end() && it->first == "prefix-update-validator") {
@@ -41,24 +41,41 @@ ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
   : m_confFileName(confFileName)
   , m_lsaRefreshTime(LSA_REFRESH_TIME_DEFAULT)
   , m_adjLsaBuildInterval(ADJ_LSA_BUILD_INTERVAL_DEFAULT)
+  , m_adjLsaBuildInitialDelay(ADJ_LSA_BUILD_INITIAL_DELAY_DEFAULT)
+  , m_adjLsaBuildMaxInterval(ADJ_LSA_BUILD_MAX_INTERVAL_DEFAULT)
   , m_routingCalcInterval(ROUTING_CALC_INTERVAL_DEFAULT)
+  , m_routingCalcInitialDelay(ROUTING_CALC_INITIAL_DELAY_DEFAULT)
+  , m_routingCalcMaxInterval(ROUTING_CALC_MAX_INTERVAL_DEFAULT)
   , m_faceDatasetFetchInterval(ndn::time::seconds(static_cast<int>(FACE_DATASET_FETCH_INTERVAL_DEFAULT)))
   , m_lsaInterestLifetime(ndn::time::seconds(static_cast<int>(LSA_INTEREST_LIFETIME_DEFAULT)))
   , m_routerDeadInterval(2 * LSA_REFRESH_TIME_DEFAULT)
   , m_interestRetryNumber(HELLO_RETRIES_DEFAULT)
   , m_interestResendTime(HELLO_TIMEOUT_DEFAULT)
   , m_infoInterestInterval(HELLO_INTERVAL_DEFAULT)
+  , m_helloIntervalMax(HELLO_INTERVAL_MAX_DEFAULT)
+  , m_isRttLinkCost(false)
+  , m_rttCostQuantum(RTT_COST_QUANTUM_DEFAULT)
+  , m_rttCostHysteresis(RTT_COST_HYSTERESIS_DEFAULT)
+  , m_probeInterval(PROBE_INTERVAL_DEFAULT)
+  , m_probeDetectMultiplier(PROBE_DETECT_MULTIPLIER_DEFAULT)
   , m_hyperbolicState(HYPERBOLIC_STATE_OFF)
   , m_corR(0)
   , m_midstState(MIDST_STATE_OFF)
   , m_hopDistance(HOP_DISTANCE_DEFAULT)
+  , m_isIncrementalDv(false)
+  , m_dvUpdateMinInterval(DV_UPDATE_MIN_INTERVAL_DEFAULT)
+  , m_dvUpdateMaxHoldDown(DV_UPDATE_MAX_HOLD_DOWN_DEFAULT)
   , m_maxFacesPerPrefix(MAX_FACES_PER_PREFIX_MIN)
   , m_syncInterestLifetime(ndn::time::milliseconds(SYNC_INTEREST_LIFETIME_DEFAULT))
+  , m_syncIbfSize(SYNC_IBF_SIZE_DEFAULT)
+  , m_lsaSegmentStorageCapacity(LSA_SEGMENT_STORAGE_CAPACITY_DEFAULT)
+  , m_lsdbSnapshotInterval(LSDB_SNAPSHOT_INTERVAL_DEFAULT)
   , m_syncProtocol(SYNC_PROTOCOL_PSYNC)
   , m_adjl()
   , m_npl()
   , m_mipl()
   , m_validator(makeCertificateFetcher(face))
+  , m_verifiedKeyCache(m_validator)
   , m_prefixUpdateValidator(std::make_unique<ndn::security::CertificateFetcherDirectFetch>(face))
   , m_keyChain(keyChain)
 {
@@ -76,11 +93,20 @@ ConfParameter::writeLog()
   NLSR_LOG_INFO("Hello Interest retry number: " << m_interestRetryNumber);
   NLSR_LOG_INFO("Hello Interest resend second: " << m_interestResendTime);
   NLSR_LOG_INFO("Info Interest interval: " << m_infoInterestInterval);
+  NLSR_LOG_INFO("Info Interest max interval: " << getHelloIntervalMax());
+  NLSR_LOG_INFO("Link cost from RTT: " << m_isRttLinkCost);
+  NLSR_LOG_INFO("RTT cost quantum: " << m_rttCostQuantum);
+  NLSR_LOG_INFO("RTT cost hysteresis (%): " << m_rttCostHysteresis);
+  NLSR_LOG_INFO("Probe interval: " << m_probeInterval);
+  NLSR_LOG_INFO("Probe detect multiplier: " << m_probeDetectMultiplier);
   NLSR_LOG_INFO("LSA refresh time: " << m_lsaRefreshTime);
   NLSR_LOG_INFO("FIB Entry refresh time: " << m_lsaRefreshTime * 2);
   NLSR_LOG_INFO("LSA Interest lifetime: " << getLsaInterestLifetime());
   NLSR_LOG_INFO("Router dead interval: " << getRouterDeadInterval());
   NLSR_LOG_INFO("Max Faces Per Prefix: " << m_maxFacesPerPrefix);
+  NLSR_LOG_INFO("Sync IBF size: " << m_syncIbfSize);
+  NLSR_LOG_INFO("LSA segment storage capacity (KB): " << m_lsaSegmentStorageCapacity);
+  NLSR_LOG_INFO("LSDB snapshot interval: " << m_lsdbSnapshotInterval);
   if (m_hyperbolicState == HYPERBOLIC_STATE_ON || m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN) {
     NLSR_LOG_INFO("Hyperbolic Routing: " << m_hyperbolicState);
     NLSR_LOG_INFO("Hyp R: " << m_corR);
@@ -91,11 +117,18 @@ ConfParameter::writeLog()
   }
   NLSR_LOG_INFO("MIDST Routing: " << m_midstState);
   NLSR_LOG_INFO("Hop Distance: " << m_hopDistance);
+  NLSR_LOG_INFO("Incremental DV: " << m_isIncrementalDv);
+  NLSR_LOG_INFO("DV update min interval: " << m_dvUpdateMinInterval);
+  NLSR_LOG_INFO("DV update max hold-down: " << m_dvUpdateMaxHoldDown);
   NLSR_LOG_INFO("State Directory: " << m_stateFileDir);
 
   // Event Intervals
   NLSR_LOG_INFO("Adjacency LSA build interval:  " << m_adjLsaBuildInterval);
+  NLSR_LOG_INFO("Adjacency LSA build initial delay:  " << m_adjLsaBuildInitialDelay);
+  NLSR_LOG_INFO("Adjacency LSA build max interval:  " << getAdjLsaBuildMaxInterval());
   NLSR_LOG_INFO("Routing calculation interval:  " << m_routingCalcInterval);
+  NLSR_LOG_INFO("Routing calculation initial delay:  " << m_routingCalcInitialDelay);
+  NLSR_LOG_INFO("Routing calculation max interval:  " << getRoutingCalcMaxInterval());
 }
 
 void
@@ -28,6 +28,7 @@
 #include "adjacency-list.hpp"
 #include "name-prefix-list.hpp"
 #include "midst-prefix-list.hpp"
+#include "security/verified-key-cache.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
@@ -60,12 +61,36 @@ enum {
   ADJ_LSA_BUILD_INTERVAL_MAX = 30
 };
 
+enum {
+  ADJ_LSA_BUILD_INITIAL_DELAY_MIN = 0,
+  ADJ_LSA_BUILD_INITIAL_DELAY_DEFAULT = 1000,
+  ADJ_LSA_BUILD_INITIAL_DELAY_MAX = 30000
+};
+
+enum {
+  ADJ_LSA_BUILD_MAX_INTERVAL_MIN = 5,
+  ADJ_LSA_BUILD_MAX_INTERVAL_DEFAULT = 60,
+  ADJ_LSA_BUILD_MAX_INTERVAL_MAX = 600
+};
+
 enum {
   ROUTING_CALC_INTERVAL_MIN = 0,
   ROUTING_CALC_INTERVAL_DEFAULT = 15,
   ROUTING_CALC_INTERVAL_MAX = 15
 };
 
+enum {
+  ROUTING_CALC_INITIAL_DELAY_MIN = 0,
+  ROUTING_CALC_INITIAL_DELAY_DEFAULT = 50,
+  ROUTING_CALC_INITIAL_DELAY_MAX = 15000
+};
+
+enum {
+  ROUTING_CALC_MAX_INTERVAL_MIN = 1,
+  ROUTING_CALC_MAX_INTERVAL_DEFAULT = 60,
+  ROUTING_CALC_MAX_INTERVAL_MAX = 600
+};
+
 
 enum {
   FACE_DATASET_FETCH_TRIES_MIN = 1,
@@ -97,6 +122,36 @@ enum {
   HELLO_INTERVAL_MAX =90
 };
 
+enum {
+  HELLO_INTERVAL_MAX_MIN = 0,
+  HELLO_INTERVAL_MAX_DEFAULT = 0,
+  HELLO_INTERVAL_MAX_MAX = 3600
+};
+
+enum {
+  RTT_COST_QUANTUM_MIN = 1,
+  RTT_COST_QUANTUM_DEFAULT = 5,
+  RTT_COST_QUANTUM_MAX = 1000
+};
+
+enum {
+  RTT_COST_HYSTERESIS_MIN = 0,
+  RTT_COST_HYSTERESIS_DEFAULT = 20,
+  RTT_COST_HYSTERESIS_MAX = 100
+};
+
+enum {
+  PROBE_INTERVAL_MIN = 0,
+  PROBE_INTERVAL_DEFAULT = 0,
+  PROBE_INTERVAL_MAX = 10000
+};
+
+enum {
+  PROBE_DETECT_MULTIPLIER_MIN = 2,
+  PROBE_DETECT_MULTIPLIER_DEFAULT = 3,
+  PROBE_DETECT_MULTIPLIER_MAX = 20
+};
+
 enum {
   MAX_FACES_PER_PREFIX_MIN = 0,
   MAX_FACES_PER_PREFIX_DEFAULT = 0,
@@ -120,12 +175,42 @@ enum {
   HOP_DISTANCE_DEFAULT = 10,
 };
 
+enum {
+  LSA_SEGMENT_STORAGE_CAPACITY_MIN = 64,
+  LSA_SEGMENT_STORAGE_CAPACITY_DEFAULT = 16384,
+  LSA_SEGMENT_STORAGE_CAPACITY_MAX = 1048576
+};
+
+enum {
+  DV_UPDATE_MIN_INTERVAL_MIN = 0,
+  DV_UPDATE_MIN_INTERVAL_DEFAULT = 100,
+  DV_UPDATE_MIN_INTERVAL_MAX = 60000
+};
+
+enum {
+  DV_UPDATE_MAX_HOLD_DOWN_MIN = 0,
+  DV_UPDATE_MAX_HOLD_DOWN_DEFAULT = 30000,
+  DV_UPDATE_MAX_HOLD_DOWN_MAX = 600000
+};
+
+enum {
+  LSDB_SNAPSHOT_INTERVAL_MIN = 0,
+  LSDB_SNAPSHOT_INTERVAL_DEFAULT = 0,
+  LSDB_SNAPSHOT_INTERVAL_MAX = 3600
+};
+
 enum {
   SYNC_INTEREST_LIFETIME_MIN = 1000,
   SYNC_INTEREST_LIFETIME_DEFAULT = 60000,
   SYNC_INTEREST_LIFETIME_MAX = 120000,
 };
 
+enum {
+  SYNC_IBF_SIZE_MIN = 10,
+  SYNC_IBF_SIZE_DEFAULT = 80,
+  SYNC_IBF_SIZE_MAX = 100000
+};
+
 /*! \brief A class to house all the configuration parameters for NLSR.
  *
  * This class is conceptually a singleton (but not mechanically) which
@@ -266,6 +351,32 @@ public:
     return m_adjLsaBuildInterval;
   }
 
+  /*! \brief Delay in milliseconds of an Adjacency LSA build after a quiet period. */
+  void
+  setAdjLsaBuildInitialDelay(uint32_t delay)
+  {
+    m_adjLsaBuildInitialDelay = delay;
+  }
+
+  uint32_t
+  getAdjLsaBuildInitialDelay() const
+  {
+    return m_adjLsaBuildInitialDelay;
+  }
+
+  /*! \brief Longest delay of an Adjacency LSA build while adjacencies keep changing. */
+  void
+  setAdjLsaBuildMaxInterval(uint32_t interval)
+  {
+    m_adjLsaBuildMaxInterval = interval;
+  }
+
+  uint32_t
+  getAdjLsaBuildMaxInterval() const
+  {
+    return std::max(m_adjLsaBuildMaxInterval, m_adjLsaBuildInterval);
+  }
+
   void
   setRoutingCalcInterval(uint32_t interval)
   {
@@ -278,6 +389,32 @@ public:
     return m_routingCalcInterval;
   }
 
+  /*! \brief Delay in milliseconds of a routing table calculation after a quiet period. */
+  void
+  setRoutingCalcInitialDelay(uint32_t delay)
+  {
+    m_routingCalcInitialDelay = delay;
+  }
+
+  uint32_t
+  getRoutingCalcInitialDelay() const
+  {
+    return m_routingCalcInitialDelay;
+  }
+
+  /*! \brief Longest delay of a routing table calculation while the LSDB keeps changing. */
+  void
+  setRoutingCalcMaxInterval(uint32_t interval)
+  {
+    m_routingCalcMaxInterval = interval;
+  }
+
+  uint32_t
+  getRoutingCalcMaxInterval() const
+  {
+    return std::max(m_routingCalcMaxInterval, m_routingCalcInterval);
+  }
+
   void
   setRouterDeadInterval(uint32_t rdt)
   {
@@ -350,6 +487,87 @@ public:
     m_infoInterestInterval = iii;
   }
 
+  /*! \brief Longest interval hellos to a stable neighbor back off to.
+   *
+   * Zero, or a value not above the hello interval, keeps the interval fixed.
+   */
+  void
+  setHelloIntervalMax(uint32_t interval)
+  {
+    m_helloIntervalMax = interval;
+  }
+
+  uint32_t
+  getHelloIntervalMax() const
+  {
+    return std::max(m_helloIntervalMax, m_infoInterestInterval);
+  }
+
+  /*! \brief Derive link costs from the smoothed hello RTT instead of the configured costs. */
+  void
+  setRttLinkCost(bool isEnabled)
+  {
+    m_isRttLinkCost = isEnabled;
+  }
+
+  bool
+  isRttLinkCostEnabled() const
+  {
+    return m_isRttLinkCost;
+  }
+
+  /*! \brief Milliseconds of smoothed RTT per unit of link cost. */
+  void
+  setRttCostQuantum(uint32_t quantum)
+  {
+    m_rttCostQuantum = ndn::time::milliseconds(quantum);
+  }
+
+  const ndn::time::milliseconds
+  getRttCostQuantum() const
+  {
+    return m_rttCostQuantum;
+  }
+
+  /*! \brief Change of a link cost, in percent, below which it is not updated. */
+  void
+  setRttCostHysteresis(uint32_t percent)
+  {
+    m_rttCostHysteresis = percent;
+  }
+
+  uint32_t
+  getRttCostHysteresis() const
+  {
+    return m_rttCostHysteresis;
+  }
+
+  /*! \brief Interval between two liveness probes to an active neighbor, zero if disabled. */
+  void
+  setProbeInterval(uint32_t interval)
+  {
+    m_probeInterval = ndn::time::milliseconds(interval);
+  }
+
+  const ndn::time::milliseconds
+  getProbeInterval() const
+  {
+    return m_probeInterval;
+  }
+
+  /*! \brief Number of probe intervals without an answer after which a neighbor is INACTIVE. */
+  void
+  setProbeDetectMultiplier(uint32_t multiplier)
+  {
+    m_probeDetectMultiplier = multiplier;
+  }
+
+  uint32_t
+  getProbeDetectMultiplier() const
+  {
+    return m_probeDetectMultiplier;
+  }
+
   void
   setHyperbolicState(int32_t ihc)
   {
@@ -414,6 +632,47 @@ public:
     return m_hopDistance;
   }
 
+  /*! \brief Ask neighbors only for the DV entries changed since their last table. */
+  void
+  setIncrementalDv(bool isEnabled)
+  {
+    m_isIncrementalDv = isEnabled;
+  }
+
+  bool
+  isIncrementalDvEnabled() const
+  {
+    return m_isIncrementalDv;
+  }
+
+  /*! \brief Minimum time between two triggered DV updates to the same neighbor. */
+  void
+  setDvUpdateMinInterval(uint32_t interval)
+  {
+    m_dvUpdateMinInterval = ndn::time::milliseconds(interval);
+  }
+
+  const ndn::time::milliseconds
+  getDvUpdateMinInterval() const
+  {
+    return m_dvUpdateMinInterval;
+  }
+
+  /*! \brief Upper bound of the hold-down between updates to a neighbor whose
+      routes keep changing.
+   */
+  void
+  setDvUpdateMaxHoldDown(uint32_t holdDown)
+  {
+    m_dvUpdateMaxHoldDown = ndn::time::milliseconds(holdDown);
+  }
+
+  const ndn::time::milliseconds
+  getDvUpdateMaxHoldDown() const
+  {
+    return m_dvUpdateMaxHoldDown;
+  }
+
   MidstPrefixList&
   getMidstPrefixList()
   {
@@ -468,6 +727,49 @@ public:
     return m_syncInterestLifetime;
   }
 
+  /*! \brief Set the number of entries the PSync IBF is sized for. */
+  void
+  setSyncIbfSize(uint32_t size)
+  {
+    m_syncIbfSize = size;
+  }
+
+  uint32_t
+  getSyncIbfSize() const
+  {
+    return m_syncIbfSize;
+  }
+
+  /*! \brief Set how often, in seconds, the LSDB is written to its snapshot file.
+   *
+   * 0 disables snapshots.
+   */
+  void
+  setLsdbSnapshotInterval(uint32_t interval)
+  {
+    m_lsdbSnapshotInterval = interval;
+  }
+
+  uint32_t
+  getLsdbSnapshotInterval() const
+  {
+    return m_lsdbSnapshotInterval;
+  }
+
+  /*! \brief Set the capacity of the LSA segment storage, in kilobytes. */
+  void
+  setLsaSegmentStorageCapacity(uint32_t capacity)
+  {
+    m_lsaSegmentStorageCapacity = capacity;
+  }
+
+  /*! \brief Get the capacity of the LSA segment storage, in kilobytes. */
+  uint32_t
+  getLsaSegmentStorageCapacity() const
+  {
+    return m_lsaSegmentStorageCapacity;
+  }
+
   AdjacencyList&
   getAdjacencyList()
   {
@@ -486,6 +788,12 @@ public:
     return m_validator;
   }
 
+  security::VerifiedKeyCache&
+  getVerifiedKeyCache()
+  {
+    return m_verifiedKeyCache;
+  }
+
   ndn::security::ValidatorConfig&
   getPrefixUpdateValidator()
   {
@@ -545,7 +853,11 @@ private:
   uint32_t  m_lsaRefreshTime;
 
   uint32_t m_adjLsaBuildInterval;
+  uint32_t m_adjLsaBuildInitialDelay;
+  uint32_t m_adjLsaBuildMaxInterval;
   uint32_t m_routingCalcInterval;
+  uint32_t m_routingCalcInitialDelay;
+  uint32_t m_routingCalcMaxInterval;
 
   uint32_t m_faceDatasetFetchTries;
   ndn::time::seconds m_faceDatasetFetchInterval;
@@ -557,6 +869,12 @@ private:
   uint32_t m_interestResendTime;
 
   uint32_t m_infoInterestInterval;
+  uint32_t m_helloIntervalMax;
+  bool m_isRttLinkCost;
+  ndn::time::milliseconds m_rttCostQuantum;
+  uint32_t m_rttCostHysteresis;
+  ndn::time::milliseconds m_probeInterval;
+  uint32_t m_probeDetectMultiplier;
 
   int32_t m_hyperbolicState;
   double m_corR;
@@ -564,12 +882,19 @@ private:
 
   int32_t m_midstState;
   double  m_hopDistance;
+  bool    m_isIncrementalDv;
+  ndn::time::milliseconds m_dvUpdateMinInterval;
+  ndn::time::milliseconds m_dvUpdateMaxHoldDown;
 
   uint32_t m_maxFacesPerPrefix;
 
   std::string m_stateFileDir;
 
   ndn::time::milliseconds m_syncInterestLifetime;
+  uint32_t m_syncIbfSize;
+
+  uint32_t m_lsaSegmentStorageCapacity;
+  uint32_t m_lsdbSnapshotInterval;
 
   SyncProtocol m_syncProtocol;
 
@@ -580,6 +905,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   NamePrefixList m_npl;
   MidstPrefixList m_mipl;
   ndn::security::ValidatorConfig m_validator;
+  security::VerifiedKeyCache m_verifiedKeyCache;
   ndn::security::ValidatorConfig m_prefixUpdateValidator;
   ndn::security::SigningInfo m_signingInfo;
   std::unordered_set<std::string> m_certs;
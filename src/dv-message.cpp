@@ -20,7 +20,8 @@
 
 #include "dv-message.hpp"
 #include "logger.hpp"
-#include "utility/name-helper.hpp"
+
+#include <ndn-cxx/security/validator-null.hpp>
 
 #include <boost/lexical_cast.hpp>
 
@@ -28,12 +29,14 @@ namespace nlsr {
 
 const std::string DvMessage::NLSR_COMPONENT = "nlsr";
 const std::string DvMessage::DIST_VECTOR_COMPONENT = "DV";
+const ndn::time::seconds DvMessage::DV_DATA_FRESHNESS = ndn::time::seconds(10);
 
 INIT_LOGGER(DvMessage);
 
 DvMessage::DvMessage(ndn::Face& face, ndn::KeyChain& keyChain,
                      ConfParameter& confParam, Lsdb& lsdb)
   : m_face(face)
+  , m_scheduler(face.getIoService())
   , m_keyChain(keyChain)
   , m_signingInfo(confParam.getSigningInfo())
   , m_confParam(confParam)
@@ -58,20 +61,51 @@ DvMessage::DvMessage(ndn::Face& face, ndn::KeyChain& keyChain,
     },
     m_signingInfo, ndn::nfd::ROUTE_FLAG_CAPTURE);
 
+  // Not every MIDST change bumps our sequence number (e.g., with state on-2).
+  // Only the encoded tables are dropped; the published segments stay until the
+  // neighbor's next request replaces them, so that a fetch in progress completes
+  m_afterLsdbModified = m_lsdb.onLsdbModified.connect(
+    [this] (std::shared_ptr<Lsa> lsa, LsdbUpdate, const auto&, const auto&) {
+      if (lsa->getType() == Lsa::Type::MIDST) {
+        for (auto& payload : m_dvPayloads) {
+          payload.second.content = ndn::Block();
+        }
+      }
+    });
+
   if (m_confParam.getMidstState() != MIDST_STATE_OFF) {
     m_lsdb.buildAndInstallOwnMidstLsa();
   }
 }
 
+DvMessage::~DvMessage()
+{
+  for (const auto& neighbor : m_neighbors) {
+    if (neighbor.second.tableFetcher != nullptr) {
+      neighbor.second.tableFetcher->stop();
+    }
+  }
+}
+
 ndn::Name
-DvMessage::buildMidstInterestPrefix(ndn::Name neighbor) const
+DvMessage::buildMidstInterestPrefix(ndn::Name neighbor, bool isFullTable) const
 {
   ndn::Name midstInterest = neighbor;
   midstInterest.append(NLSR_COMPONENT);
   midstInterest.append(DIST_VECTOR_COMPONENT);
   midstInterest.appendNumber(m_lsdb.getMidstLsaSeqNo());
-  // The info from this router is added here
-  midstInterest.append(m_confParam.getRouterPrefix().wireEncode());
+
+  // The info from this router is added here, with the "since" of an
+  // incremental request inside it, so that segment names keep the four
+  // components after DV that the validation rule expects
+  ndn::Name requester(m_confParam.getRouterPrefix());
+  if (m_confParam.isIncrementalDvEnabled() && !isFullTable) {
+    auto lsa = m_lsdb.findLsa<MidstLsa>(neighbor);
+    if (lsa != nullptr) {
+      requester.appendSequenceNumber(lsa->getSeqNo());
+    }
+  }
+  midstInterest.append(requester.wireEncode());
   NLSR_LOG_DEBUG("Building midstInterest: " << midstInterest);
   NLSR_LOG_DEBUG("With seq. number = " << m_lsdb.getMidstLsaSeqNo());
 
@@ -92,24 +126,48 @@ DvMessage::buildAdjInterestPrefix(ndn::Name neighbor) const
 }
 
 void
-DvMessage::expressInterest(const ndn::Name& neighbor, uint32_t seconds)
+DvMessage::expressInterest(const ndn::Name& neighbor, uint32_t seconds, bool isFullTable)
 {
-  ndn::Name interestName = buildMidstInterestPrefix(neighbor);
-  NLSR_LOG_DEBUG("Expressing DV Interest :" << interestName);
-
-  ndn::Interest interest(interestName);
-  interest.setInterestLifetime(ndn::time::seconds(seconds));
-  interest.setMustBeFresh(true);
-  interest.setCanBePrefix(true);
-  m_face.expressInterest(interest,
-                   std::bind(&DvMessage::onContent, this, _1, _2),
-                   [this] (const ndn::Interest& interest, const ndn::lp::Nack& nack)
-                   {
-                     NDN_LOG_TRACE("Received Nack with reason " << nack.getReason());
-                     NDN_LOG_TRACE("Treating as timeout");
-                     processInterestTimedOut(interest);
-                   },
-                   std::bind(&DvMessage::processInterestTimedOut, this, _1));
+  auto& state = m_neighbors[neighbor];
+  if (state.isTableRequestPending) {
+    NLSR_LOG_DEBUG("DV Interest to " << neighbor << " already pending");
+    state.isTableRequestNeeded = true;
+    // A full table asked for must not turn into a delta
+    state.isFullTableNeeded = state.isFullTableNeeded || isFullTable;
+    return;
+  }
+  state.isTableRequestPending = true;
+
+  ndn::Name interestName = buildMidstInterestPrefix(neighbor, isFullTable);
+  NLSR_LOG_DEBUG("Fetching DV table: " << interestName);
+
+  ndn::util::SegmentFetcher::Options options;
+  options.interestLifetime = ndn::time::seconds(seconds);
+  options.maxTimeout = ndn::time::seconds(seconds);
+
+  // Segments are checked against the verified key cache once all have arrived
+  auto segments = std::make_shared<std::vector<ndn::Data>>();
+  auto fetcher = ndn::util::SegmentFetcher::start(m_face, ndn::Interest(interestName),
+                                                  ndn::security::getAcceptAllValidator(),
+                                                  options);
+  state.tableFetcher = fetcher;
+
+  fetcher->afterSegmentReceived.connect([segments] (const ndn::Data& data) {
+    segments->push_back(data);
+  });
+
+  fetcher->onComplete.connect([this, neighbor, interestName, segments]
+                              (const ndn::ConstBufferPtr& bufferPtr) {
+    m_neighbors[neighbor].tableFetcher = nullptr;
+    onTableFetched(neighbor, interestName, bufferPtr, segments);
+  });
+
+  fetcher->onError.connect([this, neighbor] (uint32_t errorCode, const std::string& msg) {
+    NLSR_LOG_DEBUG("Failed to fetch DV table from " << neighbor << ", error code: " <<
+                   errorCode << ", message: " << msg);
+    m_neighbors[neighbor].tableFetcher = nullptr;
+    afterTableRequest(neighbor);
+  });
 
   dvMsgIncrementSignal(Statistics::PacketType::SENT_MIDST_DV_INTEREST);
 }
@@ -120,104 +178,243 @@ DvMessage::processInterest(const ndn::Name& name, const ndn::Interest& interest)
   dvMsgIncrementSignal(Statistics::PacketType::RCV_MIDST_DV_INTEREST);
   NLSR_LOG_DEBUG("Received DV interest: " << interest);
 
-  // interest name: /<ownRouter>/nlsr/DV/<neighbor>
-  ndn::Name interestName = interest.getName();
+  // interest name: /<ownRouter>/nlsr/DV/<seqNo>/<neighbor[/<since>]>[/<version>/<segmentNo>]
+  const ndn::Name& interestName = interest.getName();
+
+  if (interestName.get(-1).isSegment()) {
+    // The rest of a table whose first segment was already published
+    if (!replyFromPublishedTable(interestName)) {
+      NLSR_LOG_DEBUG("DV segment " << interestName << " is no longer available");
+    }
+    return;
+  }
+
+  if (interestName.size() < 2) {
+    NLSR_LOG_DEBUG("Malformed DV interest " << interestName << ", dropping it");
+    return;
+  }
 
   ndn::Name neighbor;
-  neighbor.wireDecode(interestName.get(-1).blockFromValue());
-  uint64_t seqNo = interestName.get(-2).toNumber();
+  ndn::optional<uint64_t> since;
+  uint64_t seqNo = 0;
+  try {
+    decodeRequester(interestName.get(-1), neighbor, since);
+    seqNo = interestName.get(-2).toNumber();
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_DEBUG("Malformed DV interest " << interestName << ": " << e.what() <<
+                   ", dropping it");
+    return;
+  }
 
   NLSR_LOG_DEBUG("From neighbor: " << neighbor);
   NLSR_LOG_DEBUG("With Seq. number = " << seqNo);
 
-  if (isThisAnUpdateTableMessage(neighbor, seqNo)) {
+  auto stateIt = m_neighbors.find(neighbor);
+  if (stateIt != m_neighbors.end() && stateIt->second.lastReceivedSeqNo != 0 &&
+      stateIt->second.lastReceivedSeqNo < seqNo) {
     NLSR_LOG_DEBUG("This is an update table message!!!");
     expressInterest(neighbor, m_confParam.getInterestResendTime());
   }
 
-  interestName.appendVersion();
-  interestName.appendSegment(0);
   NLSR_LOG_DEBUG("Processing distance-vector interest: " << interestName);
 
   if (m_confParam.getAdjacencyList().isNeighbor(neighbor)) {
-    ndn::Block block = m_lsdb.wireEncode(neighbor);
-
-    std::shared_ptr<ndn::Data> data = std::make_shared<ndn::Data>(interestName);
-    data->setFreshnessPeriod(ndn::time::seconds(10)); // 10 sec
-    data->setContent(block);
-
-    m_keyChain.sign(*data, m_signingInfo);
-    m_face.put(*data);
+    getDvContent(neighbor, since);
+    auto& payload = m_dvPayloads[neighbor];
+    // Repeated requests for an unchanged table get the segments signed the first time
+    if (payload.segments.empty() || payload.requestName != interestName) {
+      publishTable(payload, interestName);
+      NLSR_LOG_DEBUG("Published DV table for: " << interestName);
+    }
+    else {
+      NLSR_LOG_DEBUG("Reusing published DV table for: " << interestName);
+    }
+    m_face.put(*payload.segments.front());
 
     dvMsgIncrementSignal(Statistics::PacketType::SENT_MIDST_DV_DATA);
-    NLSR_LOG_DEBUG("Sending out DV data: " << data);
-    increaseNeighborsVector(neighbor);
+
+    auto& state = m_neighbors[neighbor];
+    state.lastSentSeqNo = m_lsdb.getMidstLsaSeqNo();
+    state.lastExchange = ndn::time::steady_clock::now();
+    // Installing our table bumps the neighbor's sequence number; that is
+    // not a change the neighbor needs to tell us about
+    if (state.lastReceivedSeqNo != 0) {
+      ++state.lastReceivedSeqNo;
+    }
   }
 }
 
-void
-DvMessage::processInterestTimedOut(const ndn::Interest& interest)
+const ndn::Block&
+DvMessage::getDvContent(const ndn::Name& neighbor, ndn::optional<uint64_t> since)
 {
-  // interest name: /<neighbor>/NLSR/INFO/<router>
-  const ndn::Name interestName(interest.getName());
-  NLSR_LOG_DEBUG("Interest timed out for DV: " << interestName);
+  uint64_t midstSeqNo = m_lsdb.getMidstLsaSeqNo();
+  auto& payload = m_dvPayloads[neighbor];
+
+  if (!payload.content.isValid() || payload.midstSeqNo != midstSeqNo || payload.since != since) {
+    NLSR_LOG_TRACE("Encoding DV table for " << neighbor << " at seq. number " << midstSeqNo);
+    payload.midstSeqNo = midstSeqNo;
+    payload.since = since;
+    payload.content = since ? m_lsdb.wireEncodeDelta(neighbor, *since) :
+                              m_lsdb.wireEncodeTable(neighbor);
+    payload.segments.clear();
+  }
+  else {
+    NLSR_LOG_TRACE("Reusing DV table for " << neighbor);
+  }
+
+  return payload.content;
 }
 
 void
+DvMessage::publishTable(DvPayload& payload, const ndn::Name& interestName)
+{
+  // Same segment size as the LSA segment publisher
+  const size_t maxSegmentSize = ndn::MAX_NDN_PACKET_SIZE >> 1;
+  const uint8_t* wire = payload.content.wire();
+  size_t size = payload.content.size();
+  uint64_t finalSegmentNo = size == 0 ? 0 : (size - 1) / maxSegmentSize;
+
+  ndn::Name versionedName(interestName);
+  versionedName.appendVersion();
+
+  payload.segments.clear();
+  for (uint64_t segmentNo = 0; segmentNo <= finalSegmentNo; ++segmentNo) {
+    auto data = std::make_shared<ndn::Data>(ndn::Name(versionedName).appendSegment(segmentNo));
+    size_t offset = segmentNo * maxSegmentSize;
+    data->setContent(wire + offset, std::min(maxSegmentSize, size - offset));
+    data->setFreshnessPeriod(DV_DATA_FRESHNESS);
+    data->setFinalBlock(ndn::name::Component::fromSegment(finalSegmentNo));
+    m_keyChain.sign(*data, m_signingInfo);
+    payload.segments.push_back(std::move(data));
+  }
+  payload.requestName = interestName;
+}
 
-DvMessage::onContent(const ndn::Interest& interest, const ndn::Data& data)
+bool
+DvMessage::replyFromPublishedTable(const ndn::Name& segmentName)
 {
-  dvMsgIncrementSignal(Statistics::PacketType::RCV_MIDST_DV_DATA);
-  NLSR_LOG_DEBUG("Received DV data: " << data.getName());
+  // segment name: /<ownRouter>/nlsr/DV/<seqNo>/<neighbor[/<since>]>/<version>/<segmentNo>
+  if (segmentName.size() < 3) {
+    return false;
+  }
 
-  auto kl = data.getKeyLocator();
-  if (kl && kl->getType() == ndn::tlv::Name) {
-    NLSR_LOG_DEBUG("Data signed with: " << kl->getName());
+  ndn::Name neighbor;
+  ndn::optional<uint64_t> since;
+  try {
+    decodeRequester(segmentName.get(-3), neighbor, since);
+  }
+  catch (const ndn::tlv::Error&) {
+    return false;
   }
 
-  m_confParam.getValidator().validate(data,
-                               std::bind(&DvMessage::onContentValidated, this, _1),
-                               std::bind(&DvMessage::onContentValidationFailed,
-                                                this, _1, _2));
+  auto it = m_dvPayloads.find(neighbor);
+  if (it == m_dvPayloads.end() || it->second.segments.empty()) {
+    return false;
+  }
+  const auto& segments = it->second.segments;
+  uint64_t segmentNo = segmentName.get(-1).toSegment();
+  if (segmentNo >= segments.size() ||
+      segments[segmentNo]->getName() != segmentName) {
+    return false;
+  }
+  m_face.put(*segments[segmentNo]);
+  return true;
 }
 
 void
-DvMessage::onContentValidated(const ndn::Data& data)
+DvMessage::decodeRequester(const ndn::name::Component& component, ndn::Name& router,
+                           ndn::optional<uint64_t>& since)
 {
-  // data name: /<neighbor>/NLSR/DV/SeqNo/<OwnRouter>/<version>/<segmentNo>
-  ndn::Name dataName = data.getName();
-  NLSR_LOG_DEBUG("Data validation successful for MIDST: " << dataName);
-
-  std::string chkString(DIST_VECTOR_COMPONENT);
-  int32_t lsaPosition = util::getNameComponentPosition(dataName, chkString);
+  router.wireDecode(component.blockFromValue());
+  if (!router.empty() && router.get(-1).isSequenceNumber()) {
+    since = router.get(-1).toSequenceNumber();
+    router = router.getPrefix(-1);
+  }
+  else {
+    since = ndn::nullopt;
+  }
+}
 
-  if (lsaPosition >= 0) {
-    // Extracts the prefix of the originating router from the data.
-    ndn::Name originRouter = dataName.getSubName(0, lsaPosition - 1);
-    NLSR_LOG_DEBUG("originRouter = " << originRouter);
+void
+DvMessage::processInterestTimedOut(const ndn::Interest& interest)
+{
+  // interest name: /<neighbor>/NLSR/INFO/<router>
+  const ndn::Name interestName(interest.getName());
+  NLSR_LOG_DEBUG("Interest timed out for DV: " << interestName);
+}
 
-    if (!data.hasContent()) {
-      NLSR_LOG_DEBUG("Data content block is empty.");
-      return;
-    }
+void
+DvMessage::onTableFetched(const ndn::Name& neighbor, const ndn::Name& interestName,
+                          const ndn::ConstBufferPtr& bufferPtr,
+                          const std::shared_ptr<std::vector<ndn::Data>>& segments)
+{
+  dvMsgIncrementSignal(Statistics::PacketType::RCV_MIDST_DV_DATA);
+  NLSR_LOG_DEBUG("Received DV table from " << neighbor << " in " << segments->size() <<
+                 " segments");
 
-    ndn::Block dataBlock = data.getContent();
+  // context: /<neighbor>/NLSR/DV
+  ndn::Name context(neighbor);
+  context.append(NLSR_COMPONENT).append(DIST_VECTOR_COMPONENT);
 
-    uint64_t n_seqNo = m_lsdb.wireDecode(dataBlock);
-    NLSR_LOG_DEBUG("Seq. number from originRouter: " << n_seqNo);
+  if (segments->empty()) {
+    afterTableRequest(neighbor);
+    return;
+  }
 
-    if (n_seqNo != 0) {
-      insertNeighborsVector(originRouter, n_seqNo);
-      findAndUpdateTableForActiveNeighbors(originRouter);
-    }
+  // The request stays pending until the table is merged or dropped, so that
+  // a follow-up request asks for the changes since the merged table
+  auto nValidated = std::make_shared<size_t>(0);
+  auto hasFailed = std::make_shared<bool>(false);
+  for (const auto& segment : *segments) {
+    m_confParam.getVerifiedKeyCache().validate(segment, context,
+      [=] (const ndn::Data& data) {
+        if (*hasFailed || ++*nValidated < segments->size()) {
+          return;
+        }
+        try {
+          onTableValidated(neighbor, interestName, ndn::Block(bufferPtr));
+        }
+        catch (const ndn::tlv::Error& e) {
+          NLSR_LOG_WARN("Cannot decode DV table from " << neighbor << ": " << e.what());
+        }
+        afterTableRequest(neighbor);
+      },
+      [=] (const ndn::Data& data, const ndn::security::ValidationError& ve) {
+        NLSR_LOG_DEBUG("Validation Error for " << data.getName() << ": " << ve);
+        if (!*hasFailed) {
+          *hasFailed = true;
+          afterTableRequest(neighbor);
+        }
+      });
   }
 }
 
 void
-DvMessage::onContentValidationFailed(const ndn::Data& data,
-                                 const ndn::security::ValidationError& ve)
+DvMessage::onTableValidated(const ndn::Name& neighbor, const ndn::Name& interestName,
+                            const ndn::Block& content)
 {
-  NLSR_LOG_DEBUG("Validation Error: " << ve);
+  NLSR_LOG_DEBUG("Data validation successful for MIDST: " << interestName);
+
+  uint64_t n_seqNo = m_lsdb.wireDecode(content);
+  NLSR_LOG_DEBUG("Seq. number from originRouter: " << n_seqNo);
+
+  // interest name of a delta: /<neighbor>/NLSR/DV/SeqNo/<OwnRouter/<since>>
+  ndn::Name requester;
+  ndn::optional<uint64_t> since;
+  decodeRequester(interestName.get(-1), requester, since);
+  if (n_seqNo == 0 && since) {
+    NLSR_LOG_DEBUG("Could not merge DV delta, asking for the full table");
+    expressInterest(neighbor, m_confParam.getInterestResendTime(), true);
+    return;
+  }
+
+  if (n_seqNo != 0) {
+    auto& state = m_neighbors[neighbor];
+    state.lastReceivedSeqNo = n_seqNo;
+    state.lastExchange = ndn::time::steady_clock::now();
+    findAndUpdateTableForActiveNeighbors(neighbor);
+  }
 }
 
 void
@@ -236,32 +433,93 @@ DvMessage::findAndUpdateTableForActiveNeighbors(const ndn::Name& origNeighbor)
         if ((adj.getName() != origNeighbor) &&
             (adj.getStatus() == Adjacent::STATUS_ACTIVE)) {
           NLSR_LOG_DEBUG("Active Neighbor: " << adj.getName());
-          expressInterestActiveNeighbor(adj.getName(), m_confParam.getInterestResendTime());
+          scheduleUpdate(adj.getName());
         }
       }
     }
   }
 }
 
+void
+DvMessage::scheduleUpdate(const ndn::Name& neighbor)
+{
+  auto& state = m_neighbors[neighbor];
+  if (state.isUpdateScheduled) {
+    NLSR_LOG_DEBUG("Merging DV update to " << neighbor << " into the scheduled one");
+    ++m_nMergedUpdates;
+    dvMsgIncrementSignal(Statistics::PacketType::MERGED_MIDST_DV_UPDATE);
+    return;
+  }
+
+  auto now = ndn::time::steady_clock::now();
+  auto nextUpdate = state.lastUpdateSent + state.holdDown;
+  if (nextUpdate <= now) {
+    sendUpdate(neighbor);
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Holding down DV update to " << neighbor << " for " << (nextUpdate - now));
+  state.isUpdateScheduled = true;
+  state.updateEvent = m_scheduler.schedule(nextUpdate - now, [this, neighbor] {
+    m_neighbors[neighbor].isUpdateScheduled = false;
+    // The neighbor may have gone down during the hold-down
+    if (m_confParam.getAdjacencyList().getStatusOfNeighbor(neighbor) == Adjacent::STATUS_ACTIVE) {
+      sendUpdate(neighbor);
+    }
+  });
+}
+
+void
+DvMessage::sendUpdate(const ndn::Name& neighbor)
+{
+  auto& state = m_neighbors[neighbor];
+  auto now = ndn::time::steady_clock::now();
+  ndn::time::milliseconds minInterval = m_confParam.getDvUpdateMinInterval();
+  ndn::time::milliseconds maxHoldDown = std::max(m_confParam.getDvUpdateMaxHoldDown(),
+                                                 minInterval);
+
+  if (state.holdDown > ndn::time::milliseconds::zero() &&
+      now - state.lastUpdateSent < 2 * state.holdDown) {
+    state.holdDown = std::min(2 * state.holdDown, maxHoldDown);
+  }
+  else {
+    state.holdDown = minInterval;
+  }
+  state.lastUpdateSent = now;
+
+  expressInterestActiveNeighbor(neighbor, m_confParam.getInterestResendTime());
+}
+
 void
 DvMessage::expressInterestActiveNeighbor(const ndn::Name& neighbor, uint32_t seconds)
 {
   ndn::Name interestName = buildMidstInterestPrefix(neighbor);
   NLSR_LOG_DEBUG("Expressing DV Update Table Interest: " << interestName);
 
+  m_neighbors[neighbor].isUpdatePending = true;
+
   ndn::Interest interest(interestName);
   interest.setInterestLifetime(ndn::time::seconds(seconds));
   interest.setMustBeFresh(true);
   interest.setCanBePrefix(true);
   m_face.expressInterest(interest,
-                   std::bind(&DvMessage::onContentActiveNeighbor, this, _1, _2),
-                   [this] (const ndn::Interest& interest, const ndn::lp::Nack& nack)
+                   [this, neighbor] (const ndn::Interest& interest, const ndn::Data& data)
+                   {
+                     m_neighbors[neighbor].isUpdatePending = false;
+                     onContentActiveNeighbor(interest, data);
+                   },
+                   [this, neighbor] (const ndn::Interest& interest, const ndn::lp::Nack& nack)
                    {
                      NDN_LOG_TRACE("Received Nack with reason " << nack.getReason());
                      NDN_LOG_TRACE("Treating as timeout");
+                     m_neighbors[neighbor].isUpdatePending = false;
                      processInterestTimedOut(interest);
                    },
-                   std::bind(&DvMessage::processInterestTimedOut, this, _1));
+                   [this, neighbor] (const ndn::Interest& interest)
+                   {
+                     m_neighbors[neighbor].isUpdatePending = false;
+                     processInterestTimedOut(interest);
+                   });
 
   dvMsgIncrementSignal(Statistics::PacketType::SENT_MIDST_DV_INTEREST);
 }
@@ -273,44 +531,17 @@ DvMessage::onContentActiveNeighbor(const ndn::Interest& interest, const ndn::Dat
 }
 
 void
-DvMessage::insertNeighborsVector(const ndn::Name router, uint64_t seqNo)
-{
-  for (auto& vector : processed_neighbors_vctr) {
-    if (std::get<ProcTupleIndex::NEIGHBOR>(vector) == router) {
-      std::get<ProcTupleIndex::SEQNUMBER>(vector) = seqNo;
-      NDN_LOG_DEBUG("Updated Seq. number to " << seqNo <<
-                    " for neighbor " << router);
-      return;
-    }
-  }
-   
-  processed_neighbors_vctr.emplace_back(router, seqNo);
-}
-
-void
-DvMessage::increaseNeighborsVector(const ndn::Name router)
+DvMessage::afterTableRequest(const ndn::Name& neighbor)
 {
-  for (auto& vector : processed_neighbors_vctr) {
-    if (std::get<ProcTupleIndex::NEIGHBOR>(vector) == router) {
-      std::get<ProcTupleIndex::SEQNUMBER>(vector)++;
-      NDN_LOG_DEBUG("Increased Seq. number for neighbor " << router);
-      return;
-    }
-  }   
-}
-
-bool
-DvMessage::isThisAnUpdateTableMessage(const ndn::Name& neighbor, uint64_t seqNo) const
-{
-  if (processed_neighbors_vctr.size() != 0) {
-    for (const auto& vector : processed_neighbors_vctr) {
-      if ((std::get<ProcTupleIndex::NEIGHBOR>(vector) == neighbor)
-          && (std::get<ProcTupleIndex::SEQNUMBER>(vector) < seqNo)) {
-        return true;
-      }
-    }
+  auto& state = m_neighbors[neighbor];
+  state.isTableRequestPending = false;
+
+  if (state.isTableRequestNeeded) {
+    bool isFullTable = state.isFullTableNeeded;
+    state.isTableRequestNeeded = false;
+    state.isFullTableNeeded = false;
+    expressInterest(neighbor, m_confParam.getInterestResendTime(), isFullTable);
   }
-  return false;
 }
 
 } // namespace nlsr
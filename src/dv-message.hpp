@@ -24,6 +24,12 @@
 #include "statistics.hpp"
 #include "conf-parameter.hpp"
 #include "lsdb.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/segment-fetcher.hpp>
+
+#include <unordered_map>
+#include <vector>
 
 namespace nlsr {
 
@@ -33,33 +39,107 @@ public:
   DvMessage(ndn::Face& face, ndn::KeyChain& keyChain,
             ConfParameter& confParam, Lsdb& lsdb);
 
+  ~DvMessage();
+
+  /*! \brief Builds the DV Interest name for \p neighbor.
+
+      With incremental DV enabled, and unless \p isFullTable is set, the
+      sequence number of the neighbor's table we hold is appended to the
+      encoded name of this router so that only the changes since then are
+      sent back.
+
+      The table comes back in segments named
+      /<neighbor>/nlsr/DV/<seqNo>/<thisRouter[/<since>]>/<version>/<segmentNo>.
+   */
   ndn::Name
-  buildMidstInterestPrefix(ndn::Name neighbor) const;
+  buildMidstInterestPrefix(ndn::Name neighbor, bool isFullTable = false) const;
 
   ndn::Name
   buildAdjInterestPrefix(ndn::Name neighbor) const;
 
   void
-  expressInterest(const ndn::Name& neighbor, uint32_t seconds);
+  expressInterest(const ndn::Name& neighbor, uint32_t seconds, bool isFullTable = false);
 
+  /*! \brief Answers a request for our table, or for one of its segments. */
   void
   processInterest(const ndn::Name& name, const ndn::Interest& interest);
 
-  void
-  onContent(const ndn::Interest& interest, const ndn::Data& data);
+  /*! \brief Returns how many triggered updates were merged into an already
+      scheduled one.
+   */
+  uint64_t
+  getMergedUpdateCount() const
+  {
+    return m_nMergedUpdates;
+  }
 
   ndn::util::signal::Signal<DvMessage, Statistics::PacketType> dvMsgIncrementSignal;
 
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Returns the Content block of the table sent to \p neighbor.
+   *
+   * The split-horizon table sent to a neighbor only changes when the MIDST
+   * LSDB does, so it is encoded once per own MIDST sequence number. It is
+   * segmented and signed again only when a request with a different name
+   * asks for it.
+   */
+  const ndn::Block&
+  getDvContent(const ndn::Name& neighbor, ndn::optional<uint64_t> since = ndn::nullopt);
+
+  /*! \brief Sends a table update to \p neighbor, or schedules one for when
+      its hold-down expires.
+
+      Updates triggered while one is already scheduled are merged into it.
+   */
+  void
+  scheduleUpdate(const ndn::Name& neighbor);
+
+  /*! \brief Sends the table update to \p neighbor and adjusts its hold-down.
+
+      An update that follows the previous one within twice the hold-down
+      doubles it, up to the configured maximum; a quieter neighbor goes back
+      to the minimum interval.
+   */
+  void
+  sendUpdate(const ndn::Name& neighbor);
+
 private:
+  struct DvPayload;
+
+  /*! \brief Segments and signs the table in \p payload as the answer to \p interestName. */
+  void
+  publishTable(DvPayload& payload, const ndn::Name& interestName);
+
+  /*! \brief Answers a request for a later segment of a published table.
+      \return false if the segment is not part of the table currently published
+   */
+  bool
+  replyFromPublishedTable(const ndn::Name& segmentName);
+
+  /*! \brief Decodes the requesting router, and the "since" of an incremental
+      request, from the last component of a DV Interest name.
+   */
+  static void
+  decodeRequester(const ndn::name::Component& component, ndn::Name& router,
+                  ndn::optional<uint64_t>& since);
+
   void
   processInterestTimedOut(const ndn::Interest& interest);
 
+  /*! \brief Validates the segments of a table fetched from \p neighbor.
+
+      The segments are fetched without validation and checked here against
+      the verified key cache, so that only the first segment signed by a key
+      goes through the full trust schema.
+   */
   void
-  onContentValidated(const ndn::Data& data);
+  onTableFetched(const ndn::Name& neighbor, const ndn::Name& interestName,
+                 const ndn::ConstBufferPtr& bufferPtr,
+                 const std::shared_ptr<std::vector<ndn::Data>>& segments);
 
   void
-  onContentValidationFailed(const ndn::Data& data,
-                            const ndn::security::v2::ValidationError& ve);
+  onTableValidated(const ndn::Name& neighbor, const ndn::Name& interestName,
+                   const ndn::Block& content);
 
   void
   findAndUpdateTableForActiveNeighbors(const ndn::Name& origNeighbor);
@@ -70,16 +150,17 @@ private:
   void
   onContentActiveNeighbor(const ndn::Interest& interest, const ndn::Data& data);
 
-  void
-  insertNeighborsVector(const ndn::Name router, uint64_t seqNo);
+  /*! \brief Clears the pending table request to \p neighbor and sends
+      another one if the neighbor changed in the meantime.
 
+      Called once the fetched table has been merged, or given up on, so that
+      the follow-up request already carries the merged sequence number.
+   */
   void
-  increaseNeighborsVector(const ndn::Name router);
-
-  bool
-  isThisAnUpdateTableMessage(const ndn::Name& neighbor, uint64_t seqNo) const;
+  afterTableRequest(const ndn::Name& neighbor);
 
   ndn::Face& m_face;
+  ndn::Scheduler m_scheduler;
   ndn::security::KeyChain& m_keyChain;
   const ndn::security::SigningInfo& m_signingInfo;
   ConfParameter& m_confParam;
@@ -87,14 +168,48 @@ private:
 
   static const std::string NLSR_COMPONENT;
   static const std::string DIST_VECTOR_COMPONENT;
+  static const ndn::time::seconds DV_DATA_FRESHNESS;
+
+  struct DvPayload
+  {
+    uint64_t midstSeqNo = 0;
+    ndn::optional<uint64_t> since;
+    ndn::Block content;
+    // The signed segments of content, published for requestName
+    ndn::Name requestName;
+    std::vector<std::shared_ptr<const ndn::Data>> segments;
+  };
 
-  enum ProcTupleIndex {
-    NEIGHBOR,
-    SEQNUMBER
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  struct NeighborState
+  {
+    // The neighbor's MIDST sequence number from its last table, 0 if none yet
+    uint64_t lastReceivedSeqNo = 0;
+    // Our MIDST sequence number in the last table sent to the neighbor
+    uint64_t lastSentSeqNo = 0;
+    ndn::time::steady_clock::TimePoint lastExchange;
+    // A request for the neighbor's table is in flight
+    bool isTableRequestPending = false;
+    // The neighbor changed while a request was in flight, ask again
+    bool isTableRequestNeeded = false;
+    // ... and the next request must be for the full table
+    bool isFullTableNeeded = false;
+    // An update notification to the neighbor is in flight
+    bool isUpdatePending = false;
+    std::shared_ptr<ndn::util::SegmentFetcher> tableFetcher;
+    // Triggered updates are sent at most once per hold-down
+    ndn::time::steady_clock::TimePoint lastUpdateSent;
+    ndn::time::milliseconds holdDown = ndn::time::milliseconds::zero();
+    bool isUpdateScheduled = false;
+    ndn::scheduler::ScopedEventId updateEvent;
   };
-  
-  using ProcTuple = std::tuple<ndn::Name, uint64_t>;
-  std::vector<ProcTuple> processed_neighbors_vctr;
+
+  std::unordered_map<ndn::Name, NeighborState> m_neighbors;
+  uint64_t m_nMergedUpdates = 0;
+
+  // split-horizon DV payload per neighbor
+  std::unordered_map<ndn::Name, DvPayload> m_dvPayloads;
+  ndn::util::signal::ScopedConnection m_afterLsdbModified;
 };
 
 } // namespace nlsr
@@ -25,6 +25,8 @@
 #include "logger.hpp"
 
 #include <ndn-cxx/encoding/nfd-constants.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
 
 namespace nlsr {
 
@@ -32,6 +34,11 @@ INIT_LOGGER(HelloProtocol);
 
 const std::string HelloProtocol::INFO_COMPONENT = "INFO";
 const std::string HelloProtocol::NLSR_COMPONENT = "nlsr";
+const std::string HelloProtocol::PROBE_COMPONENT = "PROBE";
+const int HelloProtocol::RTT_EWMA_DIVISOR = 8;
+const int HelloProtocol::HELLO_DATA_VERSION_INTERVALS = 10;
+const ndn::name::Component HelloProtocol::INFO_NAME_COMPONENT(INFO_COMPONENT);
+const ndn::name::Component HelloProtocol::PROBE_NAME_COMPONENT(PROBE_COMPONENT);
 
 HelloProtocol::HelloProtocol(ndn::Face& face, ndn::KeyChain& keyChain,
                              ConfParameter& confParam, RoutingTable& routingTable,
@@ -45,8 +52,6 @@ HelloProtocol::HelloProtocol(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_lsdb(lsdb)
   , m_adjacencyList(m_confParam.getAdjacencyList())
   , m_dvMessage(dvMessage)
-  , m_sequencingManager(m_confParam.getStateFileDir(),
-           m_confParam.getHyperbolicState(), m_confParam.getMidstState())
 {
   ndn::Name name(m_confParam.getRouterPrefix());
   name.append(NLSR_COMPONENT);
@@ -66,6 +71,26 @@ HelloProtocol::HelloProtocol(ndn::Face& face, ndn::KeyChain& keyChain,
       NDN_THROW(std::runtime_error("Failed to register hello prefix: " + resp));
     },
     m_signingInfo, ndn::nfd::ROUTE_FLAG_CAPTURE);
+
+  // Probes are answered even when this router sends none itself (probe-interval 0)
+  ndn::Name probeName(m_confParam.getRouterPrefix());
+  probeName.append(NLSR_COMPONENT);
+  probeName.append(PROBE_COMPONENT);
+
+  NLSR_LOG_DEBUG("Setting interest filter for probe interest: " << probeName);
+
+  m_face.setInterestFilter(ndn::InterestFilter(probeName).allowLoopback(false),
+    [this] (const auto& name, const auto& interest) {
+      processProbeInterest(name, interest);
+    },
+    [] (const auto& name) {
+      NLSR_LOG_DEBUG("Successfully registered prefix: " << name);
+    },
+    [] (const auto& name, const auto& resp) {
+      NLSR_LOG_ERROR("Failed to register prefix " << name);
+      NDN_THROW(std::runtime_error("Failed to register probe prefix: " + resp));
+    },
+    m_signingInfo, ndn::nfd::ROUTE_FLAG_CAPTURE);
 }
 
 void
@@ -77,11 +102,18 @@ HelloProtocol::expressInterest(const ndn::Name& interestName, uint32_t seconds)
   interest.setMustBeFresh(true);
   interest.setCanBePrefix(true);
   m_face.expressInterest(interest,
-    std::bind(&HelloProtocol::onContent, this, _1, _2),
+    [this, sentTime = ndn::time::steady_clock::now()] (const ndn::Interest& interest,
+                                                       const ndn::Data& data) {
+      onContent(interest, data, ndn::time::steady_clock::now() - sentTime);
+    },
     [this, seconds] (const ndn::Interest& interest, const ndn::lp::Nack& nack)
     {
       NDN_LOG_TRACE("Received Nack with reason: " << nack.getReason());
       NDN_LOG_TRACE("Will treat as timeout in " << 2 * seconds << " seconds");
+      // interest name: /<neighbor>/NLSR/INFO/<router>
+      if (interest.getName().get(-2) == INFO_NAME_COMPONENT) {
+        resetHelloInterval(interest.getName().getPrefix(-3));
+      }
       m_scheduler.schedule(ndn::time::seconds(2 * seconds),
         [this, interest] { processInterestTimedOut(interest); });
     },
@@ -111,8 +143,53 @@ HelloProtocol::sendHelloInterest(const ndn::Name& neighbor)
     NLSR_LOG_DEBUG("Sending HELLO interest: " << interestName);
   }
 
-  m_scheduler.schedule(ndn::time::seconds(m_confParam.getInfoInterestInterval()),
-                       [this, neighbor] { sendHelloInterest(neighbor); });
+  if (adjacent->getHelloInterval() == ndn::time::seconds::zero()) {
+    adjacent->setHelloInterval(ndn::time::seconds(m_confParam.getInfoInterestInterval()));
+  }
+  m_helloEvents[neighbor] = m_scheduler.schedule(adjacent->getHelloInterval(),
+                                                 [this, neighbor] { sendHelloInterest(neighbor); });
+}
+
+void
+HelloProtocol::backOffHelloInterval(const ndn::Name& neighbor)
+{
+  auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+  if (adjacent == m_adjacencyList.end()) {
+    return;
+  }
+
+  ndn::time::seconds maxInterval(m_confParam.getHelloIntervalMax());
+  ndn::time::seconds interval = std::min(2 * std::max(adjacent->getHelloInterval(),
+                                                      ndn::time::seconds(1)),
+                                         maxInterval);
+  if (interval != adjacent->getHelloInterval()) {
+    NLSR_LOG_DEBUG("Hello interval to " << neighbor << " backed off to " << interval);
+    adjacent->setHelloInterval(interval);
+  }
+}
+
+void
+HelloProtocol::resetHelloInterval(const ndn::Name& neighbor)
+{
+  auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+  if (adjacent == m_adjacencyList.end()) {
+    return;
+  }
+
+  ndn::time::seconds minInterval(m_confParam.getInfoInterestInterval());
+  if (adjacent->getHelloInterval() <= minInterval) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Hello interval to " << neighbor << " reset to " << minInterval);
+  adjacent->setHelloInterval(minInterval);
+
+  // The next periodic hello may be up to the maximum interval away
+  auto event = m_helloEvents.find(neighbor);
+  if (event != m_helloEvents.end()) {
+    event->second = m_scheduler.schedule(minInterval,
+                                         [this, neighbor] { sendHelloInterest(neighbor); });
+  }
 }
 
 void
@@ -120,13 +197,13 @@ HelloProtocol::processInterest(const ndn::Name& name,
                                const ndn::Interest& interest)
 {
   // interest name: /<neighbor>/NLSR/INFO/<router>
-  const ndn::Name interestName = interest.getName();
+  const ndn::Name& interestName = interest.getName();
 
   // increment RCV_HELLO_INTEREST
   hpIncrementSignal(Statistics::PacketType::RCV_HELLO_INTEREST);
 
   NLSR_LOG_DEBUG("Interest Received for Name: " << interestName);
-  if (interestName.get(-2).toUri() != INFO_COMPONENT) {
+  if (interestName.size() < 2 || interestName.get(-2) != INFO_NAME_COMPONENT) {
     NLSR_LOG_DEBUG("INFO_COMPONENT not found or interestName: " << interestName
                << " does not match expression");
     return;
@@ -136,13 +213,7 @@ HelloProtocol::processInterest(const ndn::Name& name,
   neighbor.wireDecode(interestName.get(-1).blockFromValue());
   NLSR_LOG_DEBUG("Neighbor: " << neighbor);
   if (m_adjacencyList.isNeighbor(neighbor)) {
-    std::shared_ptr<ndn::Data> data = std::make_shared<ndn::Data>();
-    data->setName(ndn::Name(interest.getName()).appendVersion());
-    data->setFreshnessPeriod(ndn::time::seconds(10)); // 10 sec
-    data->setContent(reinterpret_cast<const uint8_t*>(INFO_COMPONENT.c_str()),
-                                                      INFO_COMPONENT.size());
-
-    m_keyChain.sign(*data, m_signingInfo);
+    auto data = getHelloData(neighbor, interest);
 
     NLSR_LOG_DEBUG("Sending out data for name: " << interest.getName());
 
@@ -166,18 +237,95 @@ HelloProtocol::processInterest(const ndn::Name& name,
   }
 }
 
+std::shared_ptr<const ndn::Data>
+HelloProtocol::getHelloData(const ndn::Name& neighbor, const ndn::Interest& interest)
+{
+  if (m_signingInfo != m_helloDataSigningInfo) {
+    // Replaced, e.g. by ConfParameter::initializeKey(); none of the cached signatures fits
+    m_helloDataCache.clear();
+    m_helloDataSigningInfo = m_signingInfo;
+  }
+
+  auto now = ndn::time::steady_clock::now();
+  auto it = m_helloDataCache.find(neighbor);
+  if (it != m_helloDataCache.end() &&
+      now - it->second.signedAt < getHelloDataVersionWindow() &&
+      it->second.data->getName().getPrefix(-1) == interest.getName()) {
+    NLSR_LOG_TRACE("Reusing hello data " << it->second.data->getName());
+    return it->second.data;
+  }
+
+  // Signing walks the PIB anyway, so this is when a new default key or
+  // certificate is noticed; the Data cached for other neighbors go with it
+  ndn::Name signer = getSigningCertName();
+  if (signer != m_helloDataSigner) {
+    m_helloDataCache.clear();
+    m_helloDataSigner = signer;
+  }
+
+  auto data = std::make_shared<ndn::Data>();
+  data->setName(ndn::Name(interest.getName()).appendVersion());
+  data->setFreshnessPeriod(ndn::time::seconds(10)); // 10 sec
+  data->setContent(reinterpret_cast<const uint8_t*>(INFO_COMPONENT.c_str()),
+                                                    INFO_COMPONENT.size());
+
+  m_keyChain.sign(*data, m_signingInfo);
+  // Encode once so that every put() of the cached Data reuses the wire
+  data->wireEncode();
+
+  m_helloDataCache[neighbor] = {data, now};
+  return data;
+}
+
+ndn::time::seconds
+HelloProtocol::getHelloDataVersionWindow() const
+{
+  // Neighbors send hellos at up to the backed-off interval, so the window must
+  // span several of those for a signed Data to be handed out more than once
+  return ndn::time::seconds(m_confParam.getHelloIntervalMax()) * HELLO_DATA_VERSION_INTERVALS;
+}
+
+ndn::Name
+HelloProtocol::getSigningCertName() const
+{
+  using ndn::security::SigningInfo;
+  const auto& pib = m_keyChain.getPib();
+
+  try {
+    switch (m_signingInfo.getSignerType()) {
+      case SigningInfo::SIGNER_TYPE_NULL:
+        return pib.getDefaultIdentity().getDefaultKey().getDefaultCertificate().getName();
+      case SigningInfo::SIGNER_TYPE_ID:
+        return pib.getIdentity(m_signingInfo.getSignerName())
+                  .getDefaultKey().getDefaultCertificate().getName();
+      case SigningInfo::SIGNER_TYPE_KEY:
+        // key name: /<identity>/KEY/<key-id>
+        return pib.getIdentity(m_signingInfo.getSignerName().getPrefix(-2))
+                  .getKey(m_signingInfo.getSignerName()).getDefaultCertificate().getName();
+      default:
+        return m_signingInfo.getSignerName();
+    }
+  }
+  catch (const ndn::security::Pib::Error& e) {
+    // Nothing to resolve; KeyChain::sign() falls back or fails on its own
+    NLSR_LOG_TRACE("Cannot resolve the hello signing certificate: " << e.what());
+    return ndn::Name();
+  }
+}
+
 void
 HelloProtocol::processInterestTimedOut(const ndn::Interest& interest)
 {
   // interest name: /<neighbor>/NLSR/INFO/<router>
-  const ndn::Name interestName(interest.getName());
+  const ndn::Name& interestName = interest.getName();
   NLSR_LOG_DEBUG("Interest timed out for Name: " << interestName);
-  if (interestName.get(-2).toUri() != INFO_COMPONENT) {
+  if (interestName.get(-2) != INFO_NAME_COMPONENT) {
     return;
   }
   ndn::Name neighbor = interestName.getPrefix(-3);
   NLSR_LOG_DEBUG("Neighbor: " << neighbor);
   m_adjacencyList.incrementTimedOutInterestCount(neighbor);
+  resetHelloInterval(neighbor);
 
   Adjacent::Status status = m_adjacencyList.getStatusOfNeighbor(neighbor);
 
@@ -194,34 +342,174 @@ HelloProtocol::processInterestTimedOut(const ndn::Interest& interest)
     expressInterest(interestName, m_confParam.getInterestResendTime());
   }
   else if (status == Adjacent::STATUS_ACTIVE) {
-    m_adjacencyList.setStatusOfNeighbor(neighbor, Adjacent::STATUS_INACTIVE);
+    setNeighborInactive(neighbor);
+  }
+}
+
+void
+HelloProtocol::setNeighborInactive(const ndn::Name& neighbor)
+{
+  if (m_adjacencyList.getStatusOfNeighbor(neighbor) != Adjacent::STATUS_ACTIVE) {
+    return;
+  }
 
-    NLSR_LOG_DEBUG("Neighbor: " << neighbor << " status changed to INACTIVE");
+  m_adjacencyList.setStatusOfNeighbor(neighbor, Adjacent::STATUS_INACTIVE);
+  m_probes.erase(neighbor);
+  // Without probes, hellos are the only way to notice the neighbor coming back
+  resetHelloInterval(neighbor);
 
-    if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
-      m_routingTable.scheduleRoutingTableCalculation();
-    }
-    else {
-      m_lsdb.scheduleAdjLsaBuild();
-    }
+  NLSR_LOG_DEBUG("Neighbor: " << neighbor << " status changed to INACTIVE");
+
+  if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
+    m_routingTable.scheduleRoutingTableCalculation();
+  }
+  else {
+    m_lsdb.scheduleAdjLsaBuild();
+  }
+}
+
+void
+HelloProtocol::processProbeInterest(const ndn::Name& name, const ndn::Interest& interest)
+{
+  // interest name: /<router>/nlsr/PROBE/<neighbor>/<seq>
+  const ndn::Name& interestName = interest.getName();
+  if (interestName.size() < 3 || interestName.get(-3) != PROBE_NAME_COMPONENT) {
+    NLSR_LOG_DEBUG("Malformed probe interest: " << interestName);
+    return;
+  }
+
+  ndn::Name neighbor;
+  try {
+    neighbor.wireDecode(interestName.get(-2).blockFromValue());
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_DEBUG("Cannot decode neighbor name of probe " << interestName << ": " << e.what());
+    return;
+  }
+
+  if (!m_adjacencyList.isNeighbor(neighbor)) {
+    return;
+  }
+
+  NLSR_LOG_TRACE("Answering probe from " << neighbor);
+  ndn::Data data(interestName);
+  // A probe answered from a cache would say nothing about the link
+  data.setFreshnessPeriod(ndn::time::milliseconds::zero());
+  m_keyChain.sign(data, ndn::security::signingWithSha256());
+  m_face.put(data);
+}
+
+void
+HelloProtocol::startProbing(const ndn::Name& neighbor)
+{
+  if (m_confParam.getProbeInterval() == ndn::time::milliseconds::zero() ||
+      m_probes.count(neighbor) > 0) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Start probing neighbor: " << neighbor);
+  auto& probe = m_probes[neighbor];
+  probe.detectEvent = m_scheduler.schedule(m_confParam.getProbeInterval() *
+                                           m_confParam.getProbeDetectMultiplier(),
+                                           [this, neighbor] { onProbeDetectTimeout(neighbor); });
+  sendProbe(neighbor);
+}
+
+void
+HelloProtocol::sendProbe(const ndn::Name& neighbor)
+{
+  auto probe = m_probes.find(neighbor);
+  if (probe == m_probes.end()) {
+    return;
+  }
+
+  auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+  if (adjacent == m_adjacencyList.end() || adjacent->getStatus() != Adjacent::STATUS_ACTIVE) {
+    m_probes.erase(probe);
+    resetHelloInterval(neighbor);
+    return;
+  }
+
+  if (adjacent->getFaceId() != 0) {
+    // interest name: /<neighbor>/nlsr/PROBE/<router>/<seq>
+    ndn::Name interestName(neighbor);
+    interestName.append(NLSR_COMPONENT);
+    interestName.append(PROBE_COMPONENT);
+    interestName.append(m_confParam.getRouterPrefix().wireEncode());
+    interestName.appendNumber(++probe->second.seqNo);
+
+    ndn::Interest interest(interestName);
+    interest.setInterestLifetime(m_confParam.getProbeInterval() *
+                                 m_confParam.getProbeDetectMultiplier());
+    interest.setMustBeFresh(true);
+
+    NLSR_LOG_TRACE("Sending probe: " << interestName);
+    m_face.expressInterest(interest,
+      [this, neighbor] (const ndn::Interest&, const ndn::Data& data) {
+        onProbeData(neighbor, data);
+      },
+      // Missing answers are detected by the detect timer alone
+      [] (const ndn::Interest&, const ndn::lp::Nack&) {},
+      [] (const ndn::Interest&) {});
   }
+
+  probe->second.sendEvent = m_scheduler.schedule(m_confParam.getProbeInterval(),
+                                                 [this, neighbor] { sendProbe(neighbor); });
+}
+
+void
+HelloProtocol::onProbeData(const ndn::Name& neighbor, const ndn::Data& data)
+{
+  if (!ndn::security::verifyDigest(data, ndn::DigestAlgorithm::SHA256)) {
+    NLSR_LOG_DEBUG("Probe answer with a bad digest: " << data.getName());
+    return;
+  }
+
+  auto probe = m_probes.find(neighbor);
+  if (probe == m_probes.end()) {
+    return;
+  }
+
+  probe->second.detectEvent = m_scheduler.schedule(m_confParam.getProbeInterval() *
+                                                   m_confParam.getProbeDetectMultiplier(),
+                                                   [this, neighbor] { onProbeDetectTimeout(neighbor); });
+}
+
+void
+HelloProtocol::onProbeDetectTimeout(const ndn::Name& neighbor)
+{
+  NLSR_LOG_DEBUG("No probe answered by " << neighbor << " for " <<
+                 m_confParam.getProbeDetectMultiplier() << " intervals");
+
+  // Treat the neighbor as if all hello retries had failed, so that an Adjacency
+  // LSA without it can be built right away
+  m_adjacencyList.setTimedOutInterestCount(neighbor, m_confParam.getInterestRetryNumber());
+  setNeighborInactive(neighbor);
 }
 
   // This is the first function that incoming Hello data will
   // see. This checks if the data appears to be signed, and passes it
   // on to validate the content of the data.
 void
-HelloProtocol::onContent(const ndn::Interest& interest, const ndn::Data& data)
+HelloProtocol::onContent(const ndn::Interest& interest, const ndn::Data& data,
+                         ndn::time::nanoseconds rtt)
 {
   NLSR_LOG_DEBUG("Received data for INFO(name): " << data.getName());
   auto kl = data.getKeyLocator();
   if (kl && kl->getType() == ndn::tlv::Name) {
     NLSR_LOG_DEBUG("Data signed with: " << kl->getName());
   }
-  m_confParam.getValidator().validate(data,
-                                      std::bind(&HelloProtocol::onContentValidated, this, _1),
-                                      std::bind(&HelloProtocol::onContentValidationFailed,
-                                                this, _1, _2));
+  // Hello Data from a neighbor is always signed by the same key, so once its
+  // chain has been validated only the signature needs to be checked.
+  // context: /<neighbor>/NLSR/INFO/<router>
+  m_confParam.getVerifiedKeyCache().validate(data, data.getName().getPrefix(-1),
+                                             [this, rtt] (const ndn::Data& validated) {
+                                               onContentValidated(validated);
+                                               // data name: /<neighbor>/NLSR/INFO/<router>/<version>
+                                               updateLinkCost(validated.getName().getPrefix(-4), rtt);
+                                             },
+                                             std::bind(&HelloProtocol::onContentValidationFailed,
+                                                       this, _1, _2));
 }
 
 void
@@ -231,13 +519,21 @@ HelloProtocol::onContentValidated(const ndn::Data& data)
   ndn::Name dataName = data.getName();
   NLSR_LOG_DEBUG("Data validation successful for INFO(name): " << dataName);
 
-  if (dataName.get(-3).toUri() == INFO_COMPONENT) {
+  if (dataName.get(-3) == INFO_NAME_COMPONENT) {
     ndn::Name neighbor = dataName.getPrefix(-4);
 
     Adjacent::Status oldStatus = m_adjacencyList.getStatusOfNeighbor(neighbor);
+    // Only a hello answered on the first try counts towards a longer interval, and only
+    // while probes would notice a failure long before the next hello
+    if (oldStatus == Adjacent::STATUS_ACTIVE &&
+        m_adjacencyList.getTimedOutInterestCount(neighbor) == 0 &&
+        m_probes.count(neighbor) > 0) {
+      backOffHelloInterval(neighbor);
+    }
     m_adjacencyList.setStatusOfNeighbor(neighbor, Adjacent::STATUS_ACTIVE);
     m_adjacencyList.setTimedOutInterestCount(neighbor, 0);
     Adjacent::Status newStatus = m_adjacencyList.getStatusOfNeighbor(neighbor);
+    startProbing(neighbor);
 
     NLSR_LOG_DEBUG("Neighbor : " << neighbor);
     NLSR_LOG_DEBUG("Old Status: " << oldStatus << " New Status: " << newStatus);
@@ -264,6 +560,42 @@ HelloProtocol::onContentValidated(const ndn::Data& data)
   hpIncrementSignal(Statistics::PacketType::RCV_HELLO_DATA);
 }
 
+void
+HelloProtocol::updateLinkCost(const ndn::Name& neighbor, ndn::time::nanoseconds rtt)
+{
+  if (!m_confParam.isRttLinkCostEnabled() ||
+      m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
+    return;
+  }
+
+  auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+  if (adjacent == m_adjacencyList.end()) {
+    return;
+  }
+
+  // Same smoothing as TCP's SRTT (RFC 6298)
+  ndn::time::nanoseconds srtt = adjacent->getSmoothedRtt();
+  srtt = srtt == ndn::time::nanoseconds::zero() ? rtt : srtt + (rtt - srtt) / RTT_EWMA_DIVISOR;
+  adjacent->setSmoothedRtt(srtt);
+
+  double cost = std::max(1.0, std::ceil(static_cast<double>(srtt.count()) /
+                                        ndn::time::nanoseconds(m_confParam.getRttCostQuantum()).count()));
+  double oldCost = adjacent->getLinkCost();
+  NLSR_LOG_TRACE("RTT to " << neighbor << ": " << rtt << ", smoothed: " << srtt <<
+                 ", cost: " << cost);
+
+  if (std::abs(cost - oldCost) * 100 <= oldCost * m_confParam.getRttCostHysteresis()) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Link cost to " << neighbor << " changed from " << oldCost << " to " << cost);
+  adjacent->setLinkCost(cost);
+
+  if (adjacent->getStatus() == Adjacent::STATUS_ACTIVE) {
+    m_lsdb.scheduleAdjLsaBuild();
+  }
+}
+
 void
 HelloProtocol::onContentValidationFailed(const ndn::Data& data,
                                          const ndn::security::ValidationError& ve)
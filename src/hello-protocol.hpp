@@ -37,6 +37,8 @@
 #include <ndn-cxx/security/validation-error.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
 
+#include <unordered_map>
+
 namespace nlsr {
 
 class HelloProtocol
@@ -87,6 +89,16 @@ public:
   void
   processInterest(const ndn::Name& name, const ndn::Interest& interest);
 
+  /*! \brief Answers a liveness probe from a neighbor.
+   *
+   * \param interest The probe, named /\<router\>/nlsr/PROBE/\<neighbor\>/\<seq\>
+   *
+   * The answer carries no content and is signed with a SHA-256 digest only,
+   * which is enough to tell that the neighbor's Interest reached this router.
+   */
+  void
+  processProbeInterest(const ndn::Name& name, const ndn::Interest& interest);
+
   ndn::util::signal::Signal<HelloProtocol, Statistics::PacketType> hpIncrementSignal;
 
 private:
@@ -105,7 +117,7 @@ private:
   /*! \brief Verify signatures and validate incoming Hello data.
    */
   void
-  onContent(const ndn::Interest& interest, const ndn::Data& data);
+  onContent(const ndn::Interest& interest, const ndn::Data& data, ndn::time::nanoseconds rtt);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
@@ -126,6 +138,84 @@ private:
   onContentValidationFailed(const ndn::Data& data,
                             const ndn::security::ValidationError& ve);
 
+  /*! \brief Doubles the hello interval of a neighbor, up to ConfParameter::getHelloIntervalMax().
+   *
+   * Only called while the neighbor is being probed, see startProbing().
+   */
+  void
+  backOffHelloInterval(const ndn::Name& neighbor);
+
+  /*! \brief Brings the hello interval of a neighbor back to ConfParameter::getInfoInterestInterval().
+   *
+   * If the next hello was scheduled further away, it is rescheduled.
+   */
+  void
+  resetHelloInterval(const ndn::Name& neighbor);
+
+  /*! \brief Starts probing \p neighbor, if probes are enabled.
+   *
+   * A probe is sent every ConfParameter::getProbeInterval(). If none is
+   * answered for ConfParameter::getProbeDetectMultiplier() intervals, the
+   * neighbor is marked INACTIVE and probing stops until a hello succeeds again.
+   */
+  void
+  startProbing(const ndn::Name& neighbor);
+
+  void
+  sendProbe(const ndn::Name& neighbor);
+
+  void
+  onProbeData(const ndn::Name& neighbor, const ndn::Data& data);
+
+  void
+  onProbeDetectTimeout(const ndn::Name& neighbor);
+
+  /*! \brief Marks an ACTIVE neighbor INACTIVE and schedules the resulting update.
+   */
+  void
+  setNeighborInactive(const ndn::Name& neighbor);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Folds a hello RTT sample into the link cost of \p neighbor.
+   *
+   * Only used with ConfParameter::isRttLinkCostEnabled(). The smoothed RTT is
+   * quantized by ConfParameter::getRttCostQuantum(), and the link cost only
+   * changes, with an Adjacency LSA build, when the result differs from it by
+   * more than ConfParameter::getRttCostHysteresis() percent.
+   */
+  void
+  updateLinkCost(const ndn::Name& neighbor, ndn::time::nanoseconds rtt);
+
+  /*! \brief Returns the signed hello Data answering \p interest from \p neighbor.
+   *
+   * The content of a hello Data never changes, so one signed Data is kept per
+   * neighbor and handed out again until getHelloDataVersionWindow() has passed
+   * or the SigningInfo has been replaced. Only then a new version is signed.
+   *
+   * The signing certificate is resolved only when a new version is signed, so
+   * a new default key or certificate is picked up within one version window;
+   * at that point the Data cached for all neighbors are dropped.
+   */
+  std::shared_ptr<const ndn::Data>
+  getHelloData(const ndn::Name& neighbor, const ndn::Interest& interest);
+
+  /*! \brief How long a signed hello Data is handed out again.
+   *
+   * HELLO_DATA_VERSION_INTERVALS times the longest hello interval, see
+   * ConfParameter::getHelloIntervalMax().
+   */
+  ndn::time::seconds
+  getHelloDataVersionWindow() const;
+
+private:
+  /*! \brief Returns the name of the certificate that m_signingInfo currently resolves to.
+   *
+   * Unlike the SigningInfo itself, this changes when the identity gets a new
+   * default key or certificate.
+   */
+  ndn::Name
+  getSigningCertName() const;
+
 public:
   ndn::util::Signal<HelloProtocol, const ndn::Name&> onInitialHelloDataValidated;
 
@@ -139,11 +229,38 @@ private:
   Lsdb& m_lsdb;
   AdjacencyList& m_adjacencyList;
   DvMessage& m_dvMessage;
-  SequencingManager m_sequencingManager;
+
+  struct CachedHelloData
+  {
+    std::shared_ptr<const ndn::Data> data;
+    ndn::time::steady_clock::TimePoint signedAt;
+  };
+
+  std::unordered_map<ndn::Name, CachedHelloData> m_helloDataCache;
+  // What the cached Data were signed with
+  ndn::security::SigningInfo m_helloDataSigningInfo;
+  ndn::Name m_helloDataSigner;
+
+  std::unordered_map<ndn::Name, ndn::scheduler::ScopedEventId> m_helloEvents;
+
+  struct ProbeState
+  {
+    uint64_t seqNo = 0;
+    ndn::scheduler::ScopedEventId sendEvent;
+    ndn::scheduler::ScopedEventId detectEvent;
+  };
+
+  std::unordered_map<ndn::Name, ProbeState> m_probes;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   static const std::string INFO_COMPONENT;
   static const std::string NLSR_COMPONENT;
+  static const std::string PROBE_COMPONENT;
+  // Incoming names are matched against these, without converting their components to strings
+  static const ndn::name::Component INFO_NAME_COMPONENT;
+  static const ndn::name::Component PROBE_NAME_COMPONENT;
+  static const int RTT_EWMA_DIVISOR;
+  static const int HELLO_DATA_VERSION_INTERVALS;
 };
 
 } // namespace nlsr
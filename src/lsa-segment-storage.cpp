@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsa-segment-storage.hpp"
+#include "logger.hpp"
+
+namespace nlsr {
+
+INIT_LOGGER(LsaSegmentStorage);
+
+LsaSegmentStorage::LsaSegmentStorage(ndn::Scheduler& scheduler, size_t capacity,
+                                     ndn::time::nanoseconds lifetime)
+  : m_scheduler(scheduler)
+  , m_capacity(capacity)
+  , m_lifetime(lifetime)
+{
+}
+
+void
+LsaSegmentStorage::insert(const ndn::Data& segment)
+{
+  size_t segmentSize = segment.wireEncode().size();
+  if (segmentSize > m_capacity) {
+    NLSR_LOG_DEBUG("Segment " << segment.getName() << " (" << segmentSize <<
+                   " bytes) exceeds the storage capacity, not storing it");
+    return;
+  }
+
+  auto& byNameIndex = m_segments.get<byName>();
+  auto it = byNameIndex.find(segment.getName());
+  if (it != byNameIndex.end()) {
+    m_usedBytes -= it->size;
+    byNameIndex.erase(it);
+  }
+
+  while (m_usedBytes + segmentSize > m_capacity) {
+    auto& lru = m_segments.get<byLru>();
+    NLSR_LOG_TRACE("Evicting " << lru.back().getName());
+    m_usedBytes -= lru.back().size;
+    lru.pop_back();
+    ++m_nEvictions;
+  }
+
+  auto expirationTime = ndn::time::steady_clock::now() + m_lifetime;
+  m_segments.get<byLru>().push_front({std::make_shared<const ndn::Data>(segment),
+                                      segmentSize, expirationTime});
+  m_usedBytes += segmentSize;
+
+  scheduleCleanup();
+}
+
+std::shared_ptr<const ndn::Data>
+LsaSegmentStorage::find(const ndn::Interest& interest)
+{
+  const ndn::Name& interestName = interest.getName();
+  auto now = ndn::time::steady_clock::now();
+
+  auto& byNameIndex = m_segments.get<byName>();
+  for (auto it = byNameIndex.lower_bound(interestName);
+       it != byNameIndex.end() && interestName.isPrefixOf(it->getName()); ++it) {
+    if (it->expirationTime <= now) {
+      // will be removed by the pending cleanup event
+      continue;
+    }
+    if (interest.matchesData(*it->data)) {
+      ++m_nHits;
+      auto& lru = m_segments.get<byLru>();
+      lru.relocate(lru.begin(), m_segments.project<byLru>(it));
+      return it->data;
+    }
+    if (!interest.getCanBePrefix()) {
+      break;
+    }
+  }
+
+  ++m_nMisses;
+  return nullptr;
+}
+
+size_t
+LsaSegmentStorage::erase(const ndn::Name& prefix)
+{
+  auto& byNameIndex = m_segments.get<byName>();
+  auto it = byNameIndex.lower_bound(prefix);
+  size_t nErased = 0;
+  while (it != byNameIndex.end() && prefix.isPrefixOf(it->getName())) {
+    m_usedBytes -= it->size;
+    it = byNameIndex.erase(it);
+    ++nErased;
+  }
+  return nErased;
+}
+
+void
+LsaSegmentStorage::evictExpired()
+{
+  auto now = ndn::time::steady_clock::now();
+  auto& byExpirationIndex = m_segments.get<byExpiration>();
+  while (!byExpirationIndex.empty() && byExpirationIndex.begin()->expirationTime <= now) {
+    NLSR_LOG_TRACE("Expiring " << byExpirationIndex.begin()->getName());
+    m_usedBytes -= byExpirationIndex.begin()->size;
+    byExpirationIndex.erase(byExpirationIndex.begin());
+    ++m_nExpirations;
+  }
+
+  m_isCleanupScheduled = false;
+  scheduleCleanup();
+}
+
+void
+LsaSegmentStorage::scheduleCleanup()
+{
+  auto& byExpirationIndex = m_segments.get<byExpiration>();
+  if (byExpirationIndex.empty()) {
+    return;
+  }
+
+  auto earliest = byExpirationIndex.begin()->expirationTime;
+  if (m_isCleanupScheduled && m_cleanupTime <= earliest) {
+    return;
+  }
+
+  m_isCleanupScheduled = true;
+  m_cleanupTime = earliest;
+  m_cleanupEvent = m_scheduler.schedule(earliest - ndn::time::steady_clock::now(),
+                                        [this] { evictExpired(); });
+}
+
+} // namespace nlsr
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSA_SEGMENT_STORAGE_HPP
+#define NLSR_LSA_SEGMENT_STORAGE_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+namespace nlsr {
+
+/*! \brief Stores signed segments of other routers' LSAs so they can be served
+ *         to neighbors without fetching them again from the originator.
+ *
+ * The storage is bounded by the total wire size of the segments it holds. When
+ * a new segment does not fit, the least recently used segments are evicted.
+ * Each segment also expires after a fixed lifetime; expiration is driven by a
+ * single scheduler event for the whole storage rather than one per segment.
+ */
+class LsaSegmentStorage : boost::noncopyable
+{
+public:
+  /*!
+   * \param capacity Maximum total wire size of the stored segments, in bytes
+   * \param lifetime How long a segment is kept after being inserted
+   */
+  LsaSegmentStorage(ndn::Scheduler& scheduler, size_t capacity,
+                    ndn::time::nanoseconds lifetime);
+
+  /*! \brief Insert or replace a segment.
+   *
+   * Segments larger than the capacity are not stored.
+   */
+  void
+  insert(const ndn::Data& segment);
+
+  /*! \brief Find a segment that satisfies \p interest.
+   *
+   * A found segment becomes the most recently used one.
+   */
+  std::shared_ptr<const ndn::Data>
+  find(const ndn::Interest& interest);
+
+  /*! \brief Erase all segments under \p prefix.
+   *
+   * \return the number of erased segments
+   */
+  size_t
+  erase(const ndn::Name& prefix);
+
+  size_t
+  size() const
+  {
+    return m_segments.size();
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  size_t
+  getUsedBytes() const
+  {
+    return m_usedBytes;
+  }
+
+  uint64_t
+  getHitCount() const
+  {
+    return m_nHits;
+  }
+
+  uint64_t
+  getMissCount() const
+  {
+    return m_nMisses;
+  }
+
+  /*! \brief Number of segments evicted to make room for newer ones. */
+  uint64_t
+  getEvictionCount() const
+  {
+    return m_nEvictions;
+  }
+
+  /*! \brief Number of segments dropped because their lifetime elapsed. */
+  uint64_t
+  getExpirationCount() const
+  {
+    return m_nExpirations;
+  }
+
+private:
+  struct Segment
+  {
+    const ndn::Name&
+    getName() const
+    {
+      return data->getName();
+    }
+
+    std::shared_ptr<const ndn::Data> data;
+    size_t size;
+    ndn::time::steady_clock::TimePoint expirationTime;
+  };
+
+  struct byLru {};
+  struct byName {};
+  struct byExpiration {};
+
+  using SegmentContainer = boost::multi_index_container<
+    Segment,
+    boost::multi_index::indexed_by<
+      boost::multi_index::sequenced<boost::multi_index::tag<byLru>>,
+      boost::multi_index::ordered_unique<
+        boost::multi_index::tag<byName>,
+        boost::multi_index::const_mem_fun<Segment, const ndn::Name&, &Segment::getName>
+      >,
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byExpiration>,
+        boost::multi_index::member<Segment, ndn::time::steady_clock::TimePoint,
+                                   &Segment::expirationTime>
+      >
+    >
+  >;
+
+  void
+  evictExpired();
+
+  /*! \brief Make sure the cleanup event fires no later than the earliest expiration.
+   */
+  void
+  scheduleCleanup();
+
+private:
+  ndn::Scheduler& m_scheduler;
+  size_t m_capacity;
+  ndn::time::nanoseconds m_lifetime;
+
+  SegmentContainer m_segments;
+  size_t m_usedBytes = 0;
+
+  ndn::scheduler::ScopedEventId m_cleanupEvent;
+  ndn::time::steady_clock::TimePoint m_cleanupTime;
+  bool m_isCleanupScheduled = false;
+
+  uint64_t m_nHits = 0;
+  uint64_t m_nMisses = 0;
+  uint64_t m_nEvictions = 0;
+  uint64_t m_nExpirations = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSA_SEGMENT_STORAGE_HPP
@@ -25,6 +25,8 @@
 #include "adjacent.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <array>
+
 namespace nlsr {
 
 Lsa::Lsa(const ndn::Name& originRouter, uint64_t seqNo,
@@ -151,6 +153,29 @@ operator>>(std::istream& is, Lsa::Type& type)
   return is;
 }
 
+Lsa::Type
+getLsaTypeFromNameComponent(const ndn::name::Component& component)
+{
+  static const std::array<std::pair<ndn::name::Component, Lsa::Type>, 4> LSA_TYPE_COMPONENTS = [] {
+    std::array<std::pair<ndn::name::Component, Lsa::Type>, 4> table;
+    size_t i = 0;
+    for (auto type : {Lsa::Type::ADJACENCY, Lsa::Type::COORDINATE,
+                      Lsa::Type::NAME, Lsa::Type::MIDST}) {
+      std::ostringstream os;
+      os << type;
+      table[i++] = {ndn::name::Component(os.str()), type};
+    }
+    return table;
+  }();
+
+  for (const auto& entry : LSA_TYPE_COMPONENTS) {
+    if (entry.first == component) {
+      return entry.second;
+    }
+  }
+  return Lsa::Type::BASE;
+}
+
 std::string
 Lsa::getString() const
 {
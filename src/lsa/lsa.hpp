@@ -154,6 +154,15 @@ operator<<(std::ostream& os, const Lsa::Type& type);
 std::istream&
 operator>>(std::istream& is, Lsa::Type& type);
 
+/*! \brief Decode the LSA type carried in an LSA name component.
+ *
+ * Equivalent to reading the component's URI with operator>>, but compares the
+ * component against a table of precomputed ones instead of building strings.
+ * \return Lsa::Type::BASE if the component is not an LSA type
+ */
+Lsa::Type
+getLsaTypeFromNameComponent(const ndn::name::Component& component);
+
 } // namespace nlsr
 
 #endif // NLSR_LSA_LSA_HPP
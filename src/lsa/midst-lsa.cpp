@@ -27,13 +27,8 @@ MidstLsa::MidstLsa(const ndn::Name& originRouter, uint64_t seqNo,
                    const ndn::time::system_clock::TimePoint& timepoint,
                    const MidstPrefixList& mpl)
   : Lsa(originRouter, seqNo, timepoint)
+  , m_mpl(mpl)
 {
-  for (const auto& name : mpl.getNames()) {
-    double  distance = mpl.getDistance(name);
-    ndn::Name anchor = mpl.getAnchor(name);
-    uint64_t     rsn = mpl.getSeqNo(name);
-    addName(name, distance, anchor, rsn);
-  }
 }
 
 MidstLsa::MidstLsa(const ndn::Block& block)
@@ -49,19 +44,10 @@ MidstLsa::wireEncode(ndn::EncodingImpl<TAG>& block) const
 {
   size_t totalLength = 0;
 
-  // Is this a partial encode or the final encode.
-  if (tempDistance >= 0) {
-    // Encode the MidstLsa info.
-    m_mpl.setExtraDistance(tempDistance);
-    totalLength += m_mpl.wireEncode(block);
-  }
-  else {
-    // Encodes the Lsa in front of the MidstLsa info.
-    totalLength += Lsa::wireEncode(block);
+  totalLength += Lsa::wireEncode(block);
 
-    totalLength += block.prependVarNumber(totalLength);
-    totalLength += block.prependVarNumber(ndn::tlv::nlsr::MidstLsa);
-  }
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(ndn::tlv::nlsr::MidstLsa);
 
   return totalLength;
 }
@@ -120,12 +106,6 @@ MidstLsa::wireDecode(const ndn::Block& wire)
   }
 }
 
-void
-MidstLsa::setTempDistance(double distance)
-{
-  tempDistance = distance;
-}
-
 bool
 MidstLsa::isEqualContent(const MidstLsa& other) const
 {
@@ -139,11 +119,11 @@ MidstLsa::toString() const
   os << getString();
   os << "      MIDST Names:\n";
   int i = 0;
-  for (const auto& name : m_mpl.getNames()) {
-    os << "        Name " << i++ << ": " << name << "\n";
-    os << "          Distance: "  << m_mpl.getDistance(name) << "\n";
-    os << "          Anchor: "    << m_mpl.getAnchor(name) << "\n";
-    os << "          Seq. Num.: " << m_mpl.getSeqNo(name) << "\n";
+  for (const auto& entry : m_mpl) {
+    os << "        Name " << i++ << ": " << entry.name << "\n";
+    os << "          Distance: "  << entry.distance << "\n";
+    os << "          Anchor: "    << entry.anchor << "\n";
+    os << "          Seq. Num.: " << entry.seqNo << "\n";
   }
 
   return os.str();
@@ -153,35 +133,43 @@ std::tuple<bool, std::list<ndn::Name>, std::list<ndn::Name>>
 MidstLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
   auto mlsa = std::static_pointer_cast<MidstLsa>(lsa);
+  const MidstPrefixList& newMpl = mlsa->getNpl();
   bool updated = false;
 
-  // Obtain the set difference of the current and the incoming
-  // name prefix sets, and add those.
-  std::list<ndn::Name> newNames = mlsa->getNpl().getNames();
-  std::list<ndn::Name> oldNames = m_mpl.getNames();
+  // Add the names that are new and take the data of the ones that changed.
   std::list<ndn::Name> namesToAdd;
-  std::set_difference(newNames.begin(), newNames.end(), oldNames.begin(), oldNames.end(),
-                      std::inserter(namesToAdd, namesToAdd.begin()));
-  for (const auto& name : namesToAdd) {
-    double  distance = mlsa->getNpl().getDistance(name);
-    ndn::Name anchor = mlsa->getNpl().getAnchor(name);
-    uint64_t     rsn = mlsa->getNpl().getSeqNo(name);
-    
-    addName(name, distance, anchor, rsn);
+  for (const auto& entry : newMpl) {
+    size_t pos = m_mpl.find(entry.name);
+    if (pos == m_mpl.size()) {
+      namesToAdd.push_back(entry.name);
+    }
+    else {
+      auto current = m_mpl.at(pos);
+      if (current.distance == entry.distance && current.anchor == entry.anchor &&
+          current.seqNo == entry.seqNo) {
+        continue;
+      }
+    }
+    addName(entry.name, entry.distance, entry.anchor, entry.seqNo);
     updated = true;
   }
 
-  m_mpl.sort();
-
   // Also remove any names that are no longer being advertised.
   std::list<ndn::Name> namesToRemove;
-  std::set_difference(oldNames.begin(), oldNames.end(), newNames.begin(), newNames.end(),
-                      std::inserter(namesToRemove, namesToRemove.begin()));
+  for (const auto& entry : m_mpl) {
+    if (newMpl.find(entry.name) == newMpl.size()) {
+      namesToRemove.push_back(entry.name);
+    }
+  }
   for (const auto& name : namesToRemove) {
     removeName(name);
     updated = true;
   }
 
+  m_mpl.sort();
+  namesToAdd.sort();
+  namesToRemove.sort();
+
   return std::make_tuple(updated, namesToAdd, namesToRemove);
 }
 
@@ -67,7 +67,7 @@ public:
   }
 
   void
-  addName(const ndn::Name& name, double distance, ndn::Name& anchor,
+  addName(const ndn::Name& name, double distance, const ndn::Name& anchor,
           uint32_t seqNo)
   {
     m_wire.reset();
@@ -84,6 +84,11 @@ public:
   bool
   isEqualContent(const MidstLsa& other) const;
 
+  /*! \brief Encodes the LSA header wrapped in a MidstLsa element.
+
+      The prefix list is encoded separately by the distance-vector table,
+      see wireEncodeEntries().
+   */
   template<ndn::encoding::Tag TAG>
   size_t
   wireEncode(ndn::EncodingImpl<TAG>& block) const;
@@ -91,11 +96,20 @@ public:
   const ndn::Block&
   wireEncode() const override;
 
-  void
-  wireDecode(const ndn::Block& wire);
+  /*! \brief Encodes the prefix list as announced with \p extraDistance.
+
+      Does not modify the LSA, so it is safe to call for several neighbors
+      concurrently.
+   */
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncodeEntries(ndn::EncodingImpl<TAG>& block, double extraDistance) const
+  {
+    return m_mpl.wireEncode(block, extraDistance);
+  }
 
   void
-  setTempDistance(double distance);
+  wireDecode(const ndn::Block& wire);
 
   std::string
   toString() const override;
@@ -108,8 +122,6 @@ public:
 
 private:
   MidstPrefixList m_mpl;
-  
-  double tempDistance;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(MidstLsa);
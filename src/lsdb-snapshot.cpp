@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsdb-snapshot.hpp"
+#include "logger.hpp"
+#include "tlv-nlsr.hpp"
+#include "lsa/adj-lsa.hpp"
+#include "lsa/coordinate-lsa.hpp"
+#include "lsa/name-lsa.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <pwd.h>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(LsdbSnapshot);
+
+const char LsdbSnapshot::MAGIC[8] = {'N', 'L', 'S', 'R', 'L', 'S', 'D', 'B'};
+const uint32_t LsdbSnapshot::FORMAT_VERSION = 1;
+const size_t LsdbSnapshot::HEADER_SIZE = sizeof(MAGIC) + sizeof(FORMAT_VERSION);
+
+/*! \brief Flush \p path, a file or a directory, to stable storage.
+ */
+static bool
+syncPath(const std::string& path)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  bool isOk = ::fsync(fd) == 0;
+  ::close(fd);
+  return isOk;
+}
+
+LsdbSnapshot::LsdbSnapshot(const std::string& stateDir)
+  : m_filePath(stateDir)
+{
+  if (m_filePath.empty()) {
+    std::string homeDirPath(getpwuid(getuid())->pw_dir);
+    if (homeDirPath.empty()) {
+      homeDirPath = getenv("HOME");
+    }
+    m_filePath = homeDirPath;
+  }
+  m_filePath = m_filePath + "/lsdb.snapshot";
+}
+
+bool
+LsdbSnapshot::write(const std::vector<std::shared_ptr<Lsa>>& lsas) const
+{
+  std::string tmpPath = m_filePath + ".tmp";
+  std::ofstream outputFile(tmpPath, std::ios::binary | std::ios::trunc);
+
+  uint8_t version[sizeof(FORMAT_VERSION)] = {
+    static_cast<uint8_t>(FORMAT_VERSION >> 24), static_cast<uint8_t>(FORMAT_VERSION >> 16),
+    static_cast<uint8_t>(FORMAT_VERSION >> 8), static_cast<uint8_t>(FORMAT_VERSION)
+  };
+  outputFile.write(MAGIC, sizeof(MAGIC));
+  outputFile.write(reinterpret_cast<const char*>(version), sizeof(version));
+
+  size_t nWritten = 0;
+  for (const auto& lsa : lsas) {
+    if (lsa->getType() == Lsa::Type::MIDST) {
+      continue;
+    }
+    const ndn::Block& wire = lsa->wireEncode();
+    outputFile.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+    ++nWritten;
+  }
+  outputFile.close();
+
+  // The data must be on disk before the rename, otherwise a crash could leave
+  // the new name pointing to an incomplete file
+  if (!outputFile || !syncPath(tmpPath)) {
+    NLSR_LOG_WARN("Failed to write LSDB snapshot to " << tmpPath);
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+
+  if (std::rename(tmpPath.c_str(), m_filePath.c_str()) != 0) {
+    NLSR_LOG_WARN("Failed to replace LSDB snapshot " << m_filePath);
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+
+  // Persist the rename itself
+  std::string dirPath = boost::filesystem::path(m_filePath).parent_path().string();
+  if (!syncPath(dirPath.empty() ? "." : dirPath)) {
+    NLSR_LOG_WARN("Failed to sync directory " << dirPath << " after writing the LSDB snapshot");
+  }
+
+  NLSR_LOG_DEBUG("Wrote " << nWritten << " LSAs to " << m_filePath);
+  return true;
+}
+
+std::vector<std::shared_ptr<Lsa>>
+LsdbSnapshot::read() const
+{
+  std::vector<std::shared_ptr<Lsa>> lsas;
+
+  boost::system::error_code ec;
+  auto fileSize = boost::filesystem::file_size(m_filePath, ec);
+  if (ec) {
+    NLSR_LOG_DEBUG("No LSDB snapshot at " << m_filePath);
+    return lsas;
+  }
+  if (fileSize < HEADER_SIZE) {
+    NLSR_LOG_WARN("LSDB snapshot " << m_filePath << " is truncated, ignoring it");
+    return lsas;
+  }
+
+  boost::iostreams::mapped_file_source file;
+  try {
+    file.open(m_filePath);
+  }
+  catch (const std::exception& e) {
+    NLSR_LOG_WARN("Cannot map LSDB snapshot " << m_filePath << ": " << e.what());
+    return lsas;
+  }
+
+  const auto* buf = reinterpret_cast<const uint8_t*>(file.data());
+  size_t size = file.size();
+
+  uint32_t version = (uint32_t(buf[8]) << 24) | (uint32_t(buf[9]) << 16) |
+                     (uint32_t(buf[10]) << 8) | uint32_t(buf[11]);
+  if (std::memcmp(buf, MAGIC, sizeof(MAGIC)) != 0 || version != FORMAT_VERSION) {
+    NLSR_LOG_WARN("LSDB snapshot " << m_filePath << " has an unknown format, ignoring it");
+    return lsas;
+  }
+
+  size_t offset = HEADER_SIZE;
+  while (offset < size) {
+    bool isOk = false;
+    ndn::Block block;
+    std::tie(isOk, block) = ndn::Block::fromBuffer(buf + offset, size - offset);
+    if (!isOk) {
+      NLSR_LOG_WARN("Malformed element at offset " << offset << " of " << m_filePath);
+      break;
+    }
+    offset += block.size();
+
+    try {
+      switch (block.type()) {
+        case ndn::tlv::nlsr::NameLsa:
+          lsas.push_back(std::make_shared<NameLsa>(block));
+          break;
+        case ndn::tlv::nlsr::AdjacencyLsa:
+          lsas.push_back(std::make_shared<AdjLsa>(block));
+          break;
+        case ndn::tlv::nlsr::CoordinateLsa:
+          lsas.push_back(std::make_shared<CoordinateLsa>(block));
+          break;
+        default:
+          NLSR_LOG_DEBUG("Skipping element of type " << block.type() << " in " << m_filePath);
+          break;
+      }
+    }
+    catch (const ndn::tlv::Error& e) {
+      NLSR_LOG_WARN("Cannot decode LSA from " << m_filePath << ": " << e.what());
+      break;
+    }
+  }
+
+  NLSR_LOG_DEBUG("Read " << lsas.size() << " LSAs from " << m_filePath);
+  return lsas;
+}
+
+} // namespace nlsr
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSDB_SNAPSHOT_HPP
+#define NLSR_LSDB_SNAPSHOT_HPP
+
+#include "common.hpp"
+#include "lsa/lsa.hpp"
+
+#include <string>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Reads and writes the LSDB snapshot file used for warm restarts.
+ *
+ * The file starts with an 8-byte magic string and a 4-byte big-endian format
+ * version, followed by the LSAs, one after another, in their regular TLV wire
+ * encoding. Each LSA carries its own sequence number and expiration time, so
+ * the file can be memory-mapped and walked in place without any index.
+ *
+ * The file is written to a temporary name, flushed to disk and then renamed
+ * over the previous snapshot, and the directory is flushed after the rename,
+ * so a crash while writing never leaves a truncated snapshot behind.
+ */
+class LsdbSnapshot
+{
+public:
+  /*!
+   * \param stateDir Directory holding the snapshot; the home directory if empty
+   */
+  explicit
+  LsdbSnapshot(const std::string& stateDir);
+
+  /*! \brief Replace the snapshot with \p lsas.
+   *
+   * Only name, adjacency and coordinate LSAs are written.
+   * \return whether the snapshot was written
+   */
+  bool
+  write(const std::vector<std::shared_ptr<Lsa>>& lsas) const;
+
+  /*! \brief Read all LSAs from the snapshot.
+   *
+   * A missing file yields no LSAs. Reading stops at the first malformed
+   * element, keeping the LSAs decoded up to that point.
+   */
+  std::vector<std::shared_ptr<Lsa>>
+  read() const;
+
+  const std::string&
+  getFilePath() const
+  {
+    return m_filePath;
+  }
+
+private:
+  std::string m_filePath;
+
+  static const char MAGIC[8];
+  static const uint32_t FORMAT_VERSION;
+  static const size_t HEADER_SIZE;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSDB_SNAPSHOT_HPP
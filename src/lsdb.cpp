@@ -26,6 +26,8 @@
 #include "tlv-nlsr.hpp"
 #include "utility/name-helper.hpp"
 
+#include <boost/lexical_cast.hpp>
+
 namespace nlsr {
 
 INIT_LOGGER(Lsdb);
@@ -33,6 +35,9 @@ INIT_LOGGER(Lsdb);
 const ndn::time::steady_clock::TimePoint Lsdb::DEFAULT_LSA_RETRIEVAL_DEADLINE =
   ndn::time::steady_clock::TimePoint::min();
 
+const ndn::time::seconds Lsdb::SNAPSHOT_CONFIRMATION_TIMEOUT = ndn::time::seconds(120);
+const size_t Lsdb::MAX_MIDST_WITHDRAWALS = 1024;
+
 Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   : m_face(face)
   , m_scheduler(face.getIoService())
@@ -40,13 +45,15 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_sync(m_face,
            [this] (const ndn::Name& routerName, const Lsa::Type& lsaType,
                    const uint64_t& sequenceNumber) {
+             confirmProvisionalLsa(routerName, lsaType, sequenceNumber);
              return isLsaNew(routerName, lsaType, sequenceNumber);
            }, m_confParam)
   , m_lsaRefreshTime(ndn::time::seconds(m_confParam.getLsaRefreshTime()))
   , m_adjLsaBuildInterval(m_confParam.getAdjLsaBuildInterval())
   , m_thisRouterPrefix(m_confParam.getRouterPrefix())
-  , m_sequencingManager(m_confParam.getStateFileDir(), m_confParam.getHyperbolicState(),
-                        m_confParam.getMidstState())
+  , m_lsaNameLayout(m_confParam.getLsaPrefix(), m_confParam.getNetwork())
+  , m_sequencingManager(m_scheduler, m_confParam.getStateFileDir(),
+                        m_confParam.getHyperbolicState(), m_confParam.getMidstState())
   , m_onNewLsaConnection(m_sync.onNewLsa->connect(
       [this] (const ndn::Name& updateName, uint64_t sequenceNumber,
               const ndn::Name& originRouter) {
@@ -57,6 +64,12 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_segmentPublisher(m_face, keyChain)
   , m_isBuildAdjLsaScheduled(false)
   , m_adjBuildCount(0)
+  , m_adjLsaBuildThrottle(ndn::time::milliseconds(m_confParam.getAdjLsaBuildInitialDelay()),
+                          m_adjLsaBuildInterval,
+                          ndn::time::seconds(m_confParam.getAdjLsaBuildMaxInterval()))
+  , m_lsaStorage(m_scheduler, m_confParam.getLsaSegmentStorageCapacity() * 1024,
+                 ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT))
+  , m_snapshot(m_confParam.getStateFileDir())
 {
   ndn::Name name = m_confParam.getLsaPrefix();
   NLSR_LOG_DEBUG("Setting interest filter for LsaPrefix: " << name);
@@ -78,6 +91,8 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
     buildAndInstallOwnCoordinateLsa();
   }
+
+  scheduleSnapshot();
 }
 
 void
@@ -119,6 +134,9 @@ Lsdb::buildAndInstallOwnMidstLsa()
   //m_sync.publishRoutingUpdate(Lsa::Type::NAME, m_sequencingManager.getNameLsaSeq());
 
   installLsa(std::make_shared<MidstLsa>(midstLsa));
+
+  // Tables sent before this point cannot be updated incrementally
+  m_midstDeltaBase = m_sequencingManager.getMidstLsaSeq();
 }
 
 void
@@ -137,14 +155,22 @@ Lsdb::scheduleAdjLsaBuild()
     return;
   }
 
+  lsaIncrementSignal(Statistics::PacketType::ADJ_LSA_BUILD_REQUEST);
+
   if (m_isBuildAdjLsaScheduled) {
-    NLSR_LOG_DEBUG("Rescheduling Adjacency LSA build in " << m_adjLsaBuildInterval);
+    NLSR_LOG_DEBUG("Adjacency LSA build already scheduled");
+    return;
   }
-  else {
-    NLSR_LOG_DEBUG("Scheduling Adjacency LSA build in " << m_adjLsaBuildInterval);
-    m_isBuildAdjLsaScheduled = true;
+
+  auto delay = m_adjLsaBuildThrottle.next();
+  if (delay > m_adjLsaBuildThrottle.getInitialDelay()) {
+    lsaIncrementSignal(Statistics::PacketType::ADJ_LSA_BUILD_BACKOFF);
   }
-  m_scheduledAdjLsaBuild = m_scheduler.schedule(m_adjLsaBuildInterval, [this] { buildAdjLsa(); });
+  NLSR_LOG_DEBUG("Scheduling Adjacency LSA build in " << delay << " (hold time " <<
+                 m_adjLsaBuildThrottle.getCurrentHoldTime() << ")");
+  adjLsaBuildHoldTimeSignal(m_adjLsaBuildThrottle.getCurrentHoldTime());
+  m_isBuildAdjLsaScheduled = true;
+  m_scheduledAdjLsaBuild = m_scheduler.schedule(delay, [this] { buildAdjLsa(); });
 }
 
 void
@@ -176,41 +202,34 @@ Lsdb::writeLog() const
 void
 Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
 {
-  ndn::Name interestName(interest.getName());
+  const ndn::Name& interestName = interest.getName();
   NLSR_LOG_DEBUG("Interest received for LSA: " << interestName);
 
-  if (interestName[-2].isVersion()) {
+  // Components after the LSA type: the sequence number, plus version and segment if present
+  size_t nTrailing = 1;
+  if (interestName.size() >= 2 && interestName[-2].isVersion()) {
     // Interest for particular segment
     if (m_segmentPublisher.replyFromStore(interestName)) {
       NLSR_LOG_TRACE("Reply from SegmentPublisher storage");
       return;
     }
-    // Remove version and segment
-    interestName = interestName.getSubName(0, interestName.size() - 2);
-    NLSR_LOG_TRACE("Interest w/o segment and version: " << interestName);
+    // Ignore version and segment
+    nTrailing = 3;
   }
 
   // increment RCV_LSA_INTEREST
   lsaIncrementSignal(Statistics::PacketType::RCV_LSA_INTEREST);
 
-  std::string chkString("LSA");
-  int32_t lsaPosition = util::getNameComponentPosition(interestName, chkString);
-
-  // Forms the name of the router that the Interest packet came from.
-  ndn::Name originRouter = m_confParam.getNetwork();
-  originRouter.append(interestName.getSubName(lsaPosition + 1,
-                                              interestName.size() - lsaPosition - 3));
-
   // if the interest is for this router's LSA
-  if (originRouter == m_thisRouterPrefix && lsaPosition >= 0) {
-    uint64_t seqNo = interestName[-1].toNumber();
+  if (m_lsaNameLayout.matches(interestName, nTrailing) &&
+      m_lsaNameLayout.isFromRouter(interestName, nTrailing, m_thisRouterPrefix)) {
+    uint64_t seqNo = interestName[interestName.size() - nTrailing].toNumber();
     NLSR_LOG_DEBUG("LSA sequence number from interest: " << seqNo);
 
-    std::string lsaType = interestName[-2].toUri();
-    Lsa::Type interestedLsType;
-    std::istringstream(lsaType) >> interestedLsType;
+    const auto& typeComponent = m_lsaNameLayout.getTypeComponent(interestName, nTrailing);
+    Lsa::Type interestedLsType = getLsaTypeFromNameComponent(typeComponent);
     if (interestedLsType == Lsa::Type::BASE) {
-      NLSR_LOG_WARN("Received unrecognized LSA type: " << lsaType);
+      NLSR_LOG_WARN("Received unrecognized LSA type: " << typeComponent);
       return;
     }
 
@@ -220,7 +239,7 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
       NLSR_LOG_ERROR("Error: Trying to process a MIDST interest from the Lsdb.");
     }
     else {
-      if (processInterestForLsa(interest, originRouter, interestedLsType, seqNo)) {
+      if (processInterestForLsa(interest, m_thisRouterPrefix, interestedLsType, seqNo)) {
         lsaIncrementSignal(Statistics::PacketType::SENT_LSA_DATA);
       }
     }
@@ -288,10 +307,12 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
     if ((lsa->getType() == Lsa::Type::MIDST) &&
         (m_confParam.getMidstState() == MIDST_STATE_ON)) {
       increaseMidstLsaSeqNo();
+      recordMidstChange(lsa->getOriginRouter(), {});
     }
   }
   // Else this is a known name LSA, so we are updating it.
   else if (chkLsa->getSeqNo() < lsa->getSeqNo()) {
+    m_provisionalLsas.erase(std::make_pair(lsa->getOriginRouter(), lsa->getType()));
     NLSR_LOG_DEBUG("Updating " << lsa->getType() << " LSA:");
     NLSR_LOG_DEBUG(chkLsa->toString());
     chkLsa->setSeqNo(lsa->getSeqNo());
@@ -307,6 +328,7 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
       if ((lsa->getType() == Lsa::Type::MIDST) &&
           (m_confParam.getMidstState() == MIDST_STATE_ON)) {
         increaseMidstLsaSeqNo();
+        recordMidstChange(lsa->getOriginRouter(), namesToRemove);
       }
     }
 
@@ -316,6 +338,105 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
   }
 }
 
+size_t
+Lsdb::loadSnapshot()
+{
+  if (m_confParam.getLsdbSnapshotInterval() == 0) {
+    return 0;
+  }
+
+  auto now = ndn::time::system_clock::now();
+  size_t nInstalled = 0;
+  for (const auto& lsa : m_snapshot.read()) {
+    // Our own LSAs are rebuilt from the current configuration, and anything
+    // that expired while we were down must not be used
+    if (lsa->getOriginRouter() == m_thisRouterPrefix ||
+        lsa->getExpirationTimePoint() <= now ||
+        !isLsaNew(lsa->getOriginRouter(), lsa->getType(), lsa->getSeqNo())) {
+      continue;
+    }
+
+    installLsa(lsa);
+    updateHighestSeqNo(makeLsaName(lsa->getOriginRouter(), lsa->getType()), lsa->getSeqNo());
+    m_provisionalLsas.emplace(lsa->getOriginRouter(), lsa->getType());
+    ++nInstalled;
+  }
+
+  NLSR_LOG_INFO("Installed " << nInstalled << " LSAs from " << m_snapshot.getFilePath());
+
+  if (!m_provisionalLsas.empty()) {
+    m_provisionalLsaTimeoutEvent = m_scheduler.schedule(SNAPSHOT_CONFIRMATION_TIMEOUT,
+                                                        [this] { removeUnconfirmedLsas(); });
+  }
+  return nInstalled;
+}
+
+void
+Lsdb::writeSnapshot() const
+{
+  std::vector<std::shared_ptr<Lsa>> lsas;
+  for (const auto& lsa : m_lsdb) {
+    if (lsa->getOriginRouter() != m_thisRouterPrefix) {
+      lsas.push_back(lsa);
+    }
+  }
+  m_snapshot.write(lsas);
+}
+
+void
+Lsdb::scheduleSnapshot()
+{
+  auto interval = m_confParam.getLsdbSnapshotInterval();
+  if (interval == 0) {
+    return;
+  }
+
+  m_snapshotEvent = m_scheduler.schedule(ndn::time::seconds(interval), [this] {
+    writeSnapshot();
+    scheduleSnapshot();
+  });
+}
+
+void
+Lsdb::confirmProvisionalLsa(const ndn::Name& originRouter, Lsa::Type lsaType, uint64_t seqNo)
+{
+  if (m_provisionalLsas.empty()) {
+    return;
+  }
+
+  auto it = m_provisionalLsas.find(std::make_pair(originRouter, lsaType));
+  if (it == m_provisionalLsas.end()) {
+    return;
+  }
+
+  auto lsa = findLsa(originRouter, lsaType);
+  if (lsa == nullptr || lsa->getSeqNo() <= seqNo) {
+    NLSR_LOG_DEBUG("Sync confirmed " << lsaType << " LSA of " << originRouter <<
+                   " loaded from the snapshot");
+    m_provisionalLsas.erase(it);
+  }
+  else {
+    // The origin restarted with lower sequence numbers; the snapshot copy would
+    // make its current LSA look old, so drop it and let that one be fetched
+    NLSR_LOG_DEBUG("Sync reports " << seqNo << " for " << lsaType << " LSA of " <<
+                   originRouter << ", below the snapshot's " << lsa->getSeqNo() <<
+                   ", dropping the snapshot copy");
+    removeLsa(originRouter, lsaType);
+  }
+}
+
+void
+Lsdb::removeUnconfirmedLsas()
+{
+  // removeLsa() erases from m_provisionalLsas, so iterate over a copy
+  auto unconfirmed = m_provisionalLsas;
+  for (const auto& entry : unconfirmed) {
+    NLSR_LOG_DEBUG("Removing unconfirmed " << entry.second << " LSA of " << entry.first);
+    removeLsa(entry.first, entry.second);
+  }
+  m_provisionalLsas.clear();
+}
+
 void
 Lsdb::increaseMidstLsaSeqNo()
 {
@@ -335,6 +456,20 @@ Lsdb::removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
     NLSR_LOG_DEBUG("Removing " << lsaPtr->getType() << " LSA:");
     NLSR_LOG_DEBUG(lsaPtr->toString());
     m_lsdb.erase(lsaIt);
+    // Forget the sequence number as well, otherwise routers that left the
+    // network would keep an entry around forever
+    m_highestSeqNo.erase(makeLsaName(lsaPtr->getOriginRouter(), lsaPtr->getType()));
+    m_provisionalLsas.erase(std::make_pair(lsaPtr->getOriginRouter(), lsaPtr->getType()));
+
+    if (lsaPtr->getType() == Lsa::Type::MIDST &&
+        m_confParam.getMidstState() == MIDST_STATE_ON &&
+        lsaPtr->getOriginRouter() != m_thisRouterPrefix) {
+      // Our table lost these names, so neighbors have to fetch it again
+      increaseMidstLsaSeqNo();
+      recordMidstChange(lsaPtr->getOriginRouter(),
+                        std::static_pointer_cast<MidstLsa>(lsaPtr)->getNpl().getNames());
+      m_midstChangeSeq.erase(lsaPtr->getOriginRouter());
+    }
     onLsdbModified(lsaPtr, LsdbUpdate::REMOVED, {}, {});
   }
 }
@@ -361,6 +496,7 @@ Lsdb::buildAdjLsa()
       if (m_confParam.getAdjacencyList().getNumOfActiveNeighbor() > 0) {
         NLSR_LOG_DEBUG("Building and installing own Adj LSA");
         buildAndInstallOwnAdjLsa();
+        lsaIncrementSignal(Statistics::PacketType::ADJ_LSA_BUILD);
       }
       // We have no active neighbors, meaning no one can route through
       // us.  So delete our entry in the LSDB. This prevents this
@@ -465,16 +601,8 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
   // The seq no is the last
   uint64_t seqNo = interestName[-1].toNumber();
 
-  // If the LSA is not found in the list currently.
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  // If the new seq no is higher, that means the LSA is valid
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  // Otherwise, its an old/invalid LSA
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  // Do not fetch an old/invalid LSA
+  if (!updateHighestSeqNo(lsaName, seqNo)) {
     return;
   }
 
@@ -492,13 +620,8 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
     // Nlsr class subscribes to this to fetch certificates
     afterSegmentValidatedSignal(data);
 
-    // If we don't do this IMS throws: std::bad_weak_ptr: bad_weak_ptr
-    auto lsaSegment = std::make_shared<const ndn::Data>(data);
-    m_lsaStorage.insert(*lsaSegment);
-    const ndn::Name& segmentName = lsaSegment->getName();
-    // Schedule deletion of the segment
-    m_scheduler.schedule(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT),
-                         [this, segmentName] { m_lsaStorage.erase(segmentName); });
+    // The storage expires the segment on its own
+    m_lsaStorage.insert(data);
   });
 
   fetcher->onComplete.connect([=] (const ndn::ConstBufferPtr& bufferPtr) {
@@ -512,9 +635,7 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
     m_fetchers.erase(it);
   });
 
-  Lsa::Type lsaType;
-  std::istringstream(interestName[-2].toUri()) >> lsaType;
-  incrementInterestSentStats(lsaType);
+  incrementInterestSentStats(getLsaTypeFromNameComponent(interestName[-2]));
 }
 
 void
@@ -525,20 +646,33 @@ Lsdb::onFetchLsaError(uint32_t errorCode, const std::string& msg, const ndn::Nam
   NLSR_LOG_DEBUG("Failed to fetch LSA: " << lsaName << ", Error code: " << errorCode
                  << ", Message: " << msg);
 
+  auto it = m_highestSeqNo.find(lsaName);
+  if (it == m_highestSeqNo.end() || it->second != seqNo) {
+    return;
+  }
+
   if (ndn::time::steady_clock::now() < deadline) {
-    auto it = m_highestSeqNo.find(lsaName);
-    if (it != m_highestSeqNo.end() && it->second == seqNo) {
-      // If the SegmentFetcher failed due to an Interest timeout, it is safe to re-express
-      // immediately since at the least the LSA Interest lifetime has elapsed.
-      // Otherwise, it is necessary to delay the Interest re-expression to prevent
-      // the potential for constant Interest flooding.
-      ndn::time::seconds delay = m_confParam.getLsaInterestLifetime();
-
-      if (errorCode == ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT) {
-        delay = ndn::time::seconds(0);
-      }
-      m_scheduler.schedule(delay, std::bind(&Lsdb::expressInterest, this,
-                                            interestName, retransmitNo + 1, deadline));
+    // If the SegmentFetcher failed due to an Interest timeout, it is safe to re-express
+    // immediately since at the least the LSA Interest lifetime has elapsed.
+    // Otherwise, it is necessary to delay the Interest re-expression to prevent
+    // the potential for constant Interest flooding.
+    ndn::time::seconds delay = m_confParam.getLsaInterestLifetime();
+
+    if (errorCode == ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT) {
+      delay = ndn::time::seconds(0);
+    }
+    m_scheduler.schedule(delay, std::bind(&Lsdb::expressInterest, this,
+                                          interestName, retransmitNo + 1, deadline));
+  }
+  // Giving up on this LSA; if nothing was ever installed for it, there is no
+  // LSA whose expiration would clean the entry up later
+  else {
+    Lsa::Type lsaType = getLsaTypeFromNameComponent(interestName[-2]);
+    ndn::Name originRouter = m_confParam.getNetwork();
+    originRouter.append(lsaName.getSubName(m_confParam.getLsaPrefix().size(),
+                                           lsaName.size() - m_confParam.getLsaPrefix().size() - 1));
+    if (findLsa(originRouter, lsaType) == nullptr) {
+      m_highestSeqNo.erase(it);
     }
   }
 }
@@ -552,31 +686,19 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
   ndn::Name lsaName = interestName.getSubName(0, interestName.size()-1);
   uint64_t seqNo = interestName[-1].toNumber();
 
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
-    NLSR_LOG_TRACE("SeqNo for LSA(name): " << interestName << "  updated");
-  }
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  if (!updateHighestSeqNo(lsaName, seqNo)) {
     return;
   }
 
-  std::string chkString("LSA");
-  int32_t lsaPosition = util::getNameComponentPosition(interestName, chkString);
-
-  if (lsaPosition >= 0) {
+  if (m_lsaNameLayout.matches(interestName, 1)) {
     // Extracts the prefix of the originating router from the data.
-    ndn::Name originRouter = m_confParam.getNetwork();
-    originRouter.append(interestName.getSubName(lsaPosition + 1,
-                                                interestName.size() - lsaPosition - 3));
+    ndn::Name originRouter = m_lsaNameLayout.getOriginRouter(interestName, 1);
     try {
-      Lsa::Type interestedLsType;
-      std::istringstream(interestName[-2].toUri()) >> interestedLsType;
+      const auto& typeComponent = m_lsaNameLayout.getTypeComponent(interestName, 1);
+      Lsa::Type interestedLsType = getLsaTypeFromNameComponent(typeComponent);
 
       if (interestedLsType == Lsa::Type::BASE) {
-        NLSR_LOG_WARN("Received unrecognized LSA Type: " << interestName[-2].toUri());
+        NLSR_LOG_WARN("Received unrecognized LSA Type: " << typeComponent);
         return;
       }
 
@@ -606,6 +728,29 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
   }
 }
 
+bool
+Lsdb::updateHighestSeqNo(const ndn::Name& lsaName, uint64_t seqNo)
+{
+  auto result = m_highestSeqNo.emplace(lsaName, seqNo);
+  if (!result.second) {
+    if (seqNo < result.first->second) {
+      return false;
+    }
+    result.first->second = seqNo;
+  }
+  return true;
+}
+
+ndn::Name
+Lsdb::makeLsaName(const ndn::Name& originRouter, Lsa::Type lsaType) const
+{
+  // /<lsa-prefix>/<site>/<router>/<type>, the name sync hands to expressInterest
+  ndn::Name lsaName = m_confParam.getLsaPrefix();
+  lsaName.append(originRouter.getSubName(m_confParam.getNetwork().size()));
+  lsaName.append(boost::lexical_cast<std::string>(lsaType));
+  return lsaName;
+}
+
 uint64_t
 Lsdb::wireDecode(const ndn::Block& wire)
 {
@@ -628,31 +773,80 @@ Lsdb::wireDecode(const ndn::Block& wire)
 
   midstLsa.wireDecode(dataBlock);
 
-  installLsa(std::make_shared<MidstLsa>(midstLsa));
+  auto lsa = std::make_shared<MidstLsa>(midstLsa);
+  ++val;
+  if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::DvDelta) {
+    lsa = mergeDvDelta(midstLsa, *val);
+    if (lsa == nullptr) {
+      return 0;
+    }
+  }
+
+  installLsa(lsa);
   
   // Return the sequence number from the Data packet.
   return midstLsa.getSeqNo();
 }
 
+std::shared_ptr<MidstLsa>
+Lsdb::mergeDvDelta(const MidstLsa& lsa, const ndn::Block& delta)
+{
+  delta.parse();
+  auto val = delta.elements_begin();
+  if (val == delta.elements_end() || val->type() != ndn::tlv::nlsr::SequenceNumber) {
+    NDN_THROW(ndn::tlv::Error("Missing required SequenceNumber field"));
+  }
+  uint64_t since = ndn::encoding::readNonNegativeInteger(*val);
+
+  auto current = findLsa<MidstLsa>(lsa.getOriginRouter());
+  if (current == nullptr || current->getSeqNo() != since) {
+    NLSR_LOG_DEBUG("Cannot merge DV delta since " << since << " from " << lsa.getOriginRouter() <<
+                   ", our table is at " << (current ? current->getSeqNo() : 0));
+    return nullptr;
+  }
+
+  MidstPrefixList merged(current->getNpl());
+  for (++val; val != delta.elements_end(); ++val) {
+    if (val->type() == ndn::tlv::Name) {
+      merged.remove(ndn::Name(*val));
+    }
+  }
+
+  for (const auto& entry : lsa.getNpl()) {
+    merged.insert(entry.name, entry.distance, entry.anchor, entry.seqNo);
+  }
+  merged.sort();
+
+  NLSR_LOG_DEBUG("Merged DV delta since " << since << " from " << lsa.getOriginRouter());
+  return std::make_shared<MidstLsa>(lsa.getOriginRouter(), lsa.getSeqNo(),
+                                    lsa.getExpirationTimePoint(), merged);
+}
+
 template<ndn::encoding::Tag TAG>
 size_t
-Lsdb::wireEncode(ndn::EncodingImpl<TAG>& block,
-                 const ndn::Name& neighbor) const
+Lsdb::wireEncode(ndn::EncodingImpl<TAG>& block, const ndn::Name& neighbor,
+                 const DvDelta* delta) const
 {
-  double extraDistance = 0;
   size_t totalLength = 0;
-  auto   mLsaRange = getLsdbIterator<MidstLsa>();
-  
+  auto mLsaRange = getLsdbIterator<MidstLsa>();
+
   for (auto mLsaIt = mLsaRange.first; mLsaIt != mLsaRange.second; mLsaIt++) {
     auto mLsaPtr = std::static_pointer_cast<MidstLsa>(*mLsaIt);
 
     // Do not announce its own information to a neighbor. This is
     // similar to a poisoned announcement.
     if (mLsaPtr->getOriginRouter() != neighbor) {
-      extraDistance = getExtraDistance(mLsaPtr->getOriginRouter());
-      mLsaPtr->setTempDistance(extraDistance);
-      
-      totalLength += mLsaPtr->wireEncode(block);
+      double extraDistance = getExtraDistance(mLsaPtr->getOriginRouter());
+
+      if (delta != nullptr && delta->changedOrigins.count(mLsaPtr->getOriginRouter()) == 0) {
+        auto it = delta->reannounced.find(mLsaPtr->getOriginRouter());
+        if (it != delta->reannounced.end()) {
+          totalLength += it->second.wireEncode(block, extraDistance);
+        }
+        continue;
+      }
+
+      totalLength += mLsaPtr->wireEncodeEntries(block, extraDistance);
       NLSR_LOG_DEBUG("Encoding router: " << mLsaPtr->getOriginRouter() <<
                      " with additional distance: " << extraDistance);
     }
@@ -660,20 +854,16 @@ Lsdb::wireEncode(ndn::EncodingImpl<TAG>& block,
 
   // Completes encoding the MidstLsa info.
   auto lsaPtr = findOwnMidstLsa();
-  extraDistance = -1;
-  lsaPtr->setTempDistance(extraDistance);
-
   totalLength += lsaPtr->wireEncode(block);
 
-  NLSR_LOG_DEBUG("Encoding LSA router: " << lsaPtr->getOriginRouter() <<
-                 " with additional distance: " << extraDistance);
+  NLSR_LOG_DEBUG("Encoding LSA header of router: " << lsaPtr->getOriginRouter());
   totalLength += block.prependVarNumber(totalLength);
   totalLength += block.prependVarNumber(ndn::tlv::nlsr::Lsdb);
 
   return totalLength;
 }
 
-const ndn::Block&
+ndn::Block
 Lsdb::wireEncode(const ndn::Name& neighbor) const
 {
   ndn::EncodingEstimator estimator;
@@ -682,9 +872,108 @@ Lsdb::wireEncode(const ndn::Name& neighbor) const
   ndn::EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer, neighbor);
 
-  m_wire = buffer.block();
+  return buffer.block();
+}
+
+ndn::Block
+Lsdb::wireEncodeTable(const ndn::Name& neighbor) const
+{
+  ndn::Block content(ndn::tlv::Content);
+  content.push_back(wireEncode(neighbor));
+  content.encode();
+  return content;
+}
+
+ndn::Block
+Lsdb::wireEncodeDelta(const ndn::Name& neighbor, uint64_t since) const
+{
+  if (since < m_midstDeltaBase || since > getMidstLsaSeqNo()) {
+    NLSR_LOG_DEBUG("No DV change log since " << since << ", sending the full table");
+    return wireEncodeTable(neighbor);
+  }
+
+  DvDelta delta;
+  delta.since = since;
+  for (const auto& withdrawal : m_midstWithdrawals) {
+    if (withdrawal.first > since) {
+      delta.withdrawn.insert(withdrawal.second);
+    }
+  }
+
+  // A name withdrawn from one origin may still be reachable through another
+  std::set<ndn::Name> stillReachable;
+  auto mLsaRange = getLsdbIterator<MidstLsa>();
+  for (auto mLsaIt = mLsaRange.first; mLsaIt != mLsaRange.second; mLsaIt++) {
+    auto mLsaPtr = std::static_pointer_cast<MidstLsa>(*mLsaIt);
+    const ndn::Name& originRouter = mLsaPtr->getOriginRouter();
+    if (originRouter == neighbor) {
+      continue;
+    }
+
+    auto changeIt = m_midstChangeSeq.find(originRouter);
+    bool isChanged = changeIt == m_midstChangeSeq.end() || changeIt->second > since;
+    if (isChanged) {
+      delta.changedOrigins.insert(originRouter);
+    }
+
+    for (const auto& entry : mLsaPtr->getNpl()) {
+      if (delta.withdrawn.count(entry.name) == 0) {
+        continue;
+      }
+      if (!isChanged) {
+        delta.reannounced[originRouter].insert(entry.name, entry.distance,
+                                               entry.anchor, entry.seqNo);
+      }
+      stillReachable.insert(entry.name);
+    }
+  }
+  for (const auto& name : stillReachable) {
+    delta.withdrawn.erase(name);
+  }
+
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator, neighbor, &delta);
 
-  return m_wire;
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer, neighbor, &delta);
+
+  // DvDelta := DV-DELTA-TYPE TLV-LENGTH
+  //              SequenceNumber
+  //              Name*
+  ndn::Block deltaBlock(ndn::tlv::nlsr::DvDelta);
+  deltaBlock.push_back(ndn::encoding::makeNonNegativeIntegerBlock(ndn::tlv::nlsr::SequenceNumber,
+                                                                  since));
+  for (const auto& name : delta.withdrawn) {
+    deltaBlock.push_back(name.wireEncode());
+  }
+  deltaBlock.encode();
+
+  NLSR_LOG_DEBUG("DV delta for " << neighbor << " since " << since << ": " <<
+                 delta.changedOrigins.size() << " changed origins, " <<
+                 delta.withdrawn.size() << " withdrawn names");
+
+  ndn::Block content(ndn::tlv::Content);
+  content.push_back(buffer.block());
+  content.push_back(deltaBlock);
+  content.encode();
+  return content;
+}
+
+void
+Lsdb::recordMidstChange(const ndn::Name& originRouter,
+                        const std::list<ndn::Name>& withdrawnNames)
+{
+  uint64_t seqNo = m_sequencingManager.getMidstLsaSeq();
+  m_midstChangeSeq[originRouter] = seqNo;
+
+  for (const auto& name : withdrawnNames) {
+    m_midstWithdrawals.emplace_back(seqNo, name);
+  }
+  while (m_midstWithdrawals.size() > MAX_MIDST_WITHDRAWALS) {
+    // Deltas since an older sequence number would miss this withdrawal
+    m_midstDeltaBase = std::max(m_midstDeltaBase, m_midstWithdrawals.front().first);
+    m_midstWithdrawals.pop_front();
+  }
 }
 
 double
@@ -32,17 +32,25 @@
 #include "test-access-control.hpp"
 #include "communication/sync-logic-handler.hpp"
 #include "statistics.hpp"
+#include "lsa-segment-storage.hpp"
+#include "lsdb-snapshot.hpp"
+#include "utility/exponential-throttle.hpp"
+#include "utility/name-helper.hpp"
 
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/util/signal.hpp>
 #include <ndn-cxx/util/time.hpp>
 #include <ndn-cxx/util/segment-fetcher.hpp>
-#include <ndn-cxx/ims/in-memory-storage-persistent.hpp>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/composite_key.hpp>
 
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+
 #include <PSync/segment-publisher.hpp>
 
 namespace nlsr {
@@ -105,17 +113,67 @@ public:
     return m_sequencingManager.getMidstLsaSeq();
   }
 
+  /*! \brief Returns the number of LSA names whose sequence number is tracked. */
+  size_t
+  getTrackedSeqNoCount() const
+  {
+    return m_highestSeqNo.size();
+  }
+
+  /*! \brief The changes sent in an incremental distance-vector table. */
+  struct DvDelta
+  {
+    uint64_t since = 0;
+    // origins whose whole prefix list is sent
+    std::set<ndn::Name> changedOrigins;
+    // entries of unchanged origins that were withdrawn from another origin
+    std::map<ndn::Name, MidstPrefixList> reannounced;
+    std::set<ndn::Name> withdrawn;
+  };
+
+  /*! \brief Installs the distance-vector table received from a neighbor.
+
+      A table followed by a DvDelta is merged into the neighbor's current
+      table, provided that is the table the delta was computed from.
+
+      \return the neighbor's MIDST sequence number, or 0 if the delta
+               could not be merged.
+  */
   uint64_t
   wireDecode(const ndn::Block& wire);
 
+  /*! \brief Encodes the distance-vector table for \p neighbor into \p block.
+
+      The per-neighbor extra distance is applied while encoding; neither the
+      LSDB nor the LSAs in it are modified, so tables for several neighbors
+      can be encoded concurrently into separate buffers.
+  */
   template<ndn::encoding::Tag TAG>
   size_t
-  wireEncode(ndn::EncodingImpl<TAG>& block,
-                 const ndn::Name& neighbor) const;
+  wireEncode(ndn::EncodingImpl<TAG>& block, const ndn::Name& neighbor,
+             const DvDelta* delta = nullptr) const;
 
-  const ndn::Block&
+  ndn::Block
   wireEncode(const ndn::Name& neighbor) const;
 
+  /*! \brief Encodes the full table for \p neighbor as it is sent in DV Data.
+
+      \return a Content block, the form wireDecode() expects
+  */
+  ndn::Block
+  wireEncodeTable(const ndn::Name& neighbor) const;
+
+  /*! \brief Encodes what changed in the table for \p neighbor after our
+      MIDST sequence number \p since.
+
+      Falls back to the full table if the change log no longer reaches
+      back to \p since.
+
+      \return a Content block
+  */
+  ndn::Block
+  wireEncodeDelta(const ndn::Name& neighbor, uint64_t since) const;
+
   void
   expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
                   ndn::time::steady_clock::TimePoint deadline = DEFAULT_LSA_RETRIEVAL_DEADLINE);
@@ -126,7 +184,12 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   buildAndInstallOwnCoordinateLsa();
 
 public:
-  /*! \brief Schedules a build of this router's LSA. */
+  /*! \brief Schedules a build of this router's LSA.
+   *
+   * The build is throttled: a request while a build is pending is merged
+   * into it, and builds that follow each other closely are spaced out
+   * exponentially, from the Adjacency LSA build interval up to its maximum.
+   */
   void
   scheduleAdjLsaBuild();
 
@@ -279,6 +342,21 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   installLsa(std::shared_ptr<Lsa> lsa);
 
+  /*! \brief Install the unexpired LSAs of other routers saved in the snapshot file.
+   *
+   * The LSAs are provisional until sync announces the same or a newer sequence
+   * number for them; an older one replaces them. Those still unconfirmed after
+   * SNAPSHOT_CONFIRMATION_TIMEOUT are removed.
+   *
+   * \return the number of installed LSAs
+   */
+  size_t
+  loadSnapshot();
+
+  /*! \brief Write the LSAs of other routers to the snapshot file. */
+  void
+  writeSnapshot() const;
+
   /*! \brief Remove a name LSA from the LSDB.
     \param router The name of the router that published the LSA to remove.
     \param lsaType The type of the LSA.
@@ -353,6 +431,33 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& interestName);
 
+  /*! \brief Records \p seqNo as the highest known one for \p lsaName.
+   *
+   * \return false if a higher sequence number is already known, i.e. the LSA
+   *         is outdated and should not be fetched or installed
+   */
+  bool
+  updateHighestSeqNo(const ndn::Name& lsaName, uint64_t seqNo);
+
+  void
+  scheduleSnapshot();
+
+  /*! \brief Confirm a provisional LSA if sync reports \p seqNo or newer for it.
+   *
+   * A lower \p seqNo means the origin restarted its sequence numbers; the
+   * provisional LSA is removed so that the one sync reports gets fetched.
+   */
+  void
+  confirmProvisionalLsa(const ndn::Name& originRouter, Lsa::Type lsaType, uint64_t seqNo);
+
+  /*! \brief Remove the provisional LSAs that sync has not confirmed. */
+  void
+  removeUnconfirmedLsas();
+
+  /*! \brief Returns the name sync uses for an LSA, without the sequence number. */
+  ndn::Name
+  makeLsaName(const ndn::Name& originRouter, Lsa::Type lsaType) const;
+
   void
   emitSegmentValidatedSignal(const ndn::Data& data)
   {
@@ -374,8 +479,24 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::shared_ptr<MidstLsa>
   findOwnMidstLsa() const;
 
+  /*! \brief Records that the MIDST LSA of \p originRouter changed at our
+      current MIDST sequence number, withdrawing \p withdrawnNames.
+  */
+  void
+  recordMidstChange(const ndn::Name& originRouter, const std::list<ndn::Name>& withdrawnNames);
+
+  /*! \brief Merges \p delta into the installed table of the neighbor that sent \p lsa.
+
+      \return the merged LSA, or nullptr if the installed table is not the
+               one the delta was computed from.
+  */
+  std::shared_ptr<MidstLsa>
+  mergeDvDelta(const MidstLsa& lsa, const ndn::Block& delta);
+
 public:
   ndn::util::Signal<Lsdb, Statistics::PacketType> lsaIncrementSignal;
+  // Hold time of the Adjacency LSA build throttle, each time a build is scheduled
+  ndn::util::Signal<Lsdb, ndn::time::milliseconds> adjLsaBuildHoldTimeSignal;
   ndn::util::Signal<Lsdb, ndn::Data> afterSegmentValidatedSignal;
   using AfterLsdbModified = ndn::util::Signal<Lsdb, std::shared_ptr<Lsa>, LsdbUpdate,
                                               std::list<ndn::Name>, std::list<ndn::Name>>;
@@ -394,12 +515,19 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::time::seconds m_lsaRefreshTime;
   ndn::time::seconds m_adjLsaBuildInterval;
   const ndn::Name& m_thisRouterPrefix;
+  const util::LsaNameLayout m_lsaNameLayout;
 
-  mutable ndn::Block m_wire;
+  // Change log for incremental DV: the MIDST sequence number at which each
+  // origin last changed, and the names withdrawn since m_midstDeltaBase
+  std::unordered_map<ndn::Name, uint64_t> m_midstChangeSeq;
+  std::deque<std::pair<uint64_t, ndn::Name>> m_midstWithdrawals;
+  uint64_t m_midstDeltaBase = 0;
+  static const size_t MAX_MIDST_WITHDRAWALS;
 
   // Maps the name of an LSA to its highest known sequence number from sync;
-  // Used to stop NLSR from trying to fetch outdated LSAs
-  std::map<ndn::Name, uint64_t> m_highestSeqNo;
+  // Used to stop NLSR from trying to fetch outdated LSAs. Entries are dropped
+  // when the LSA is removed or when fetching it is given up.
+  std::unordered_map<ndn::Name, uint64_t> m_highestSeqNo;
 
   SequencingManager m_sequencingManager;
 
@@ -411,8 +539,17 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   bool m_isBuildAdjLsaScheduled;
   int64_t m_adjBuildCount;
   ndn::scheduler::ScopedEventId m_scheduledAdjLsaBuild;
+  util::ExponentialThrottle m_adjLsaBuildThrottle;
+
+  LsaSegmentStorage m_lsaStorage;
+
+  LsdbSnapshot m_snapshot;
+  ndn::scheduler::ScopedEventId m_snapshotEvent;
+  // LSAs loaded from the snapshot that sync has not confirmed yet
+  std::set<std::pair<ndn::Name, Lsa::Type>> m_provisionalLsas;
+  ndn::scheduler::ScopedEventId m_provisionalLsaTimeoutEvent;
 
-  ndn::InMemoryStoragePersistent m_lsaStorage;
+  static const ndn::time::seconds SNAPSHOT_CONFIRMATION_TIMEOUT;
 
   const ndn::Name::Component NAME_COMPONENT = ndn::Name::Component("lsdb");
   static const ndn::time::steady_clock::TimePoint DEFAULT_LSA_RETRIEVAL_DEADLINE;
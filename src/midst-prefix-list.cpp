@@ -22,110 +22,142 @@
 #include "common.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <numeric>
+
 
 namespace nlsr {
 
+const ndn::Name MidstPrefixList::INVALID_NAME;
+
 MidstPrefixList::MidstPrefixList() = default;
 
 MidstPrefixList::MidstPrefixList(const std::initializer_list<ndn::Name>& names)
 {
-  std::vector<MidstPrefixList::NameTuple> nameTuples;
-  std::transform(names.begin(), names.end(), std::back_inserter(nameTuples),
-    [] (const ndn::Name& name) {
-      return MidstPrefixList::NameTuple{name, 0, {""}, 0};
-    });
-  m_names = std::move(nameTuples);
+  for (const auto& name : names) {
+    insert(name, 0, {""}, 0);
+  }
 }
 
 MidstPrefixList::MidstPrefixList(const std::initializer_list<MidstPrefixList::NameTuple>& namesAndData)
-  : m_names(namesAndData)
 {
+  for (const auto& tuple : namesAndData) {
+    insert(std::get<MidstIndex::NAME>(tuple), std::get<MidstIndex::DISTANCE>(tuple),
+           std::get<MidstIndex::ANCHOR>(tuple), std::get<MidstIndex::SEQNO>(tuple));
+  }
 }
 
 MidstPrefixList::~MidstPrefixList()
 {
 }
 
-std::vector<MidstPrefixList::NameTuple>::iterator
-MidstPrefixList::get(const ndn::Name& name)
-{
-  return std::find_if(m_names.begin(), m_names.end(),
-                      [&] (const MidstPrefixList::NameTuple& tuple) {
-                        return name == std::get<MidstPrefixList::MidstIndex::NAME>(tuple);
-                      });
-}
-
 bool
 MidstPrefixList::insert(const ndn::Name& name, const double distance,
                        const ndn::Name& anchor, const uint32_t seqNo)
 {
-  auto pairItr = get(name);
-
-  // If the name is not found, add it at the end of the vector.
-  if (pairItr == m_names.end()) {
-    m_names.push_back(std::tie(name, distance, anchor, seqNo));
-    return true;
+  auto result = m_index.emplace(name, m_names.size());
+
+  // If the name is not found, add it at the end of the arrays.
+  if (result.second) {
+    m_names.push_back(name);
+    m_distances.push_back(distance);
+    m_anchors.push_back(anchor);
+    m_seqNos.push_back(seqNo);
   }
   else {
-  // If the name is found, *** GENERATE LOG *** and replace it.
-    *pairItr = std::tie(name, distance, anchor, seqNo);
-    return true;
+    size_t pos = result.first->second;
+    m_distances[pos] = distance;
+    m_anchors[pos] = anchor;
+    m_seqNos[pos] = seqNo;
   }
-  return false;
+  return true;
 }
 
 bool
 MidstPrefixList::remove(const ndn::Name& name)
 {
-  auto pairItr = get(name);
-  if (pairItr != m_names.end()) {
-    m_names.erase(pairItr);
-    return true;
+  auto it = m_index.find(name);
+  if (it == m_index.end()) {
+    return false;
+  }
+
+  size_t pos = it->second;
+  size_t last = m_names.size() - 1;
+  m_index.erase(it);
+  if (pos != last) {
+    m_names[pos] = std::move(m_names[last]);
+    m_distances[pos] = m_distances[last];
+    m_anchors[pos] = std::move(m_anchors[last]);
+    m_seqNos[pos] = m_seqNos[last];
+    m_index[m_names[pos]] = pos;
   }
-  return false;
+  m_names.pop_back();
+  m_distances.pop_back();
+  m_anchors.pop_back();
+  m_seqNos.pop_back();
+  return true;
 }
 
 bool
 MidstPrefixList::operator==(const MidstPrefixList& other) const
 {
-  return m_names == other.m_names;
+  return m_names == other.m_names &&
+         m_distances == other.m_distances &&
+         m_anchors == other.m_anchors &&
+         m_seqNos == other.m_seqNos;
 }
 
 void
 MidstPrefixList::sort()
 {
-  std::sort(m_names.begin(), m_names.end());
+  std::vector<size_t> order(m_names.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [this] (size_t lhs, size_t rhs) { return m_names[lhs] < m_names[rhs]; });
+
+  std::vector<ndn::Name> names;
+  std::vector<double> distances;
+  std::vector<ndn::Name> anchors;
+  std::vector<uint32_t> seqNos;
+  names.reserve(order.size());
+  distances.reserve(order.size());
+  anchors.reserve(order.size());
+  seqNos.reserve(order.size());
+  for (size_t pos : order) {
+    names.push_back(std::move(m_names[pos]));
+    distances.push_back(m_distances[pos]);
+    anchors.push_back(std::move(m_anchors[pos]));
+    seqNos.push_back(m_seqNos[pos]);
+  }
+  m_names = std::move(names);
+  m_distances = std::move(distances);
+  m_anchors = std::move(anchors);
+  m_seqNos = std::move(seqNos);
+
+  reindex();
 }
 
 void
-MidstPrefixList::setExtraDistance(double distance) const
+MidstPrefixList::reindex()
 {
-  extraDistance = distance;
+  m_index.clear();
+  m_index.reserve(m_names.size());
+  for (size_t pos = 0; pos < m_names.size(); ++pos) {
+    m_index.emplace(m_names[pos], pos);
+  }
 }
 
-NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(MidstPrefixList);
-
 template<ndn::encoding::Tag TAG>
 size_t
-MidstPrefixList::wireEncode(ndn::EncodingImpl<TAG>& block) const
+MidstPrefixList::wireEncode(ndn::EncodingImpl<TAG>& block, double extraDistance) const
 {
-  double m_distance  = 0;
   size_t totalLength = 0;
 
-  for (const auto& a_name : m_names) {
-    totalLength += prependDoubleBlock(block, ndn::tlv::nlsr::SeqNo, 
-                   std::get<MidstPrefixList::MidstIndex::SEQNO>(a_name));
-
-    totalLength += std::get<MidstPrefixList::MidstIndex::ANCHOR>(a_name).
-                   wireEncode(block);
-
-    m_distance   = std::get<MidstPrefixList::MidstIndex::DISTANCE>(a_name) +
-                   extraDistance;
-    totalLength += prependDoubleBlock(block, ndn::tlv::nlsr::Distance, 
-                   m_distance);
-
-    totalLength += std::get<MidstPrefixList::MidstIndex::NAME>(a_name).
-                   wireEncode(block);
+  for (size_t pos = 0; pos < m_names.size(); ++pos) {
+    totalLength += prependDoubleBlock(block, ndn::tlv::nlsr::SeqNo, m_seqNos[pos]);
+    totalLength += m_anchors[pos].wireEncode(block);
+    totalLength += prependDoubleBlock(block, ndn::tlv::nlsr::Distance,
+                                      m_distances[pos] + extraDistance);
+    totalLength += m_names[pos].wireEncode(block);
   }
 
   totalLength += block.prependVarNumber(totalLength);
@@ -134,22 +166,21 @@ MidstPrefixList::wireEncode(ndn::EncodingImpl<TAG>& block) const
   return totalLength;
 }
 
-const ndn::Block&
-MidstPrefixList::wireEncode() const
-{
-  //if (m_wire.hasWire()) {
-  //  return m_wire;
-  //}
+template size_t
+MidstPrefixList::wireEncode<ndn::encoding::EncoderTag>(ndn::EncodingBuffer&, double) const;
+template size_t
+MidstPrefixList::wireEncode<ndn::encoding::EstimatorTag>(ndn::EncodingEstimator&, double) const;
 
+ndn::Block
+MidstPrefixList::wireEncode(double extraDistance) const
+{
   ndn::EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  size_t estimatedSize = wireEncode(estimator, extraDistance);
 
   ndn::EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
+  wireEncode(buffer, extraDistance);
 
-  m_wire = buffer.block();
-
-  return m_wire;
+  return buffer.block();
 }
 
 
@@ -166,7 +197,7 @@ MidstPrefixList::wireDecode(const ndn::Block& wire)
   auto val2 = dataBlock.elements_begin();
 
   while (val2 != dataBlock.elements_end()) {
-    if (val2 != m_wire.elements_end() && val2->type() == ndn::tlv::Name) {
+    if (val2 != dataBlock.elements_end() && val2->type() == ndn::tlv::Name) {
       name.wireDecode(*val2);
       ++val2;
     }
@@ -174,7 +205,7 @@ MidstPrefixList::wireDecode(const ndn::Block& wire)
       NDN_THROW(ndn::tlv::Error("Missing required Name field"));
     }
 
-    if (val2 != m_wire.elements_end() && val2->type() == ndn::tlv::nlsr::Distance) {
+    if (val2 != dataBlock.elements_end() && val2->type() == ndn::tlv::nlsr::Distance) {
       distance = ndn::encoding::readDouble(*val2);
       ++val2;
     }
@@ -182,7 +213,7 @@ MidstPrefixList::wireDecode(const ndn::Block& wire)
       NDN_THROW(ndn::tlv::Error("Missing required Distance field"));
    }
 
-    if (val2 != m_wire.elements_end() && val2->type() == ndn::tlv::Name) {
+    if (val2 != dataBlock.elements_end() && val2->type() == ndn::tlv::Name) {
       anchor.wireDecode(*val2);
       ++val2;
     }
@@ -190,7 +221,7 @@ MidstPrefixList::wireDecode(const ndn::Block& wire)
       NDN_THROW(ndn::tlv::Error("Missing required Anchor field"));
     }
 
-    if (val2 != m_wire.elements_end() && val2->type() == ndn::tlv::nlsr::SeqNo) {
+    if (val2 != dataBlock.elements_end() && val2->type() == ndn::tlv::nlsr::SeqNo) {
       seqNo = ndn::encoding::readDouble(*val2);
       ++val2;
     }
@@ -205,22 +236,15 @@ MidstPrefixList::wireDecode(const ndn::Block& wire)
 std::list<ndn::Name>
 MidstPrefixList::getNames() const
 {
-  std::list<ndn::Name> names;
-  for (const auto& a_name : m_names) {
-    names.push_back(std::get<MidstPrefixList::MidstIndex::NAME>(a_name));
-  }
-  return names;
+  return std::list<ndn::Name>(m_names.begin(), m_names.end());
 }
 
 double
 MidstPrefixList::getDistance(const ndn::Name& name) const
 {
-  auto Itr = std::find_if(m_names.begin(), m_names.end(),
-                         [&] (const MidstPrefixList::NameTuple& tuple) {
-                           return name == std::get<MidstPrefixList::MidstIndex::NAME>(tuple);
-                         });
-  if (Itr != m_names.end()) {
-    return std::get<MidstPrefixList::MidstIndex::DISTANCE>(*Itr);
+  auto it = m_index.find(name);
+  if (it != m_index.end()) {
+    return m_distances[it->second];
   }
   return -1; // I would prefer an INVALID value
 }
@@ -228,38 +252,19 @@ MidstPrefixList::getDistance(const ndn::Name& name) const
 const ndn::Name&
 MidstPrefixList::getAnchor(const ndn::Name& name) const
 {
-  auto Itr = std::find_if(m_names.begin(), m_names.end(),
-                         [&] (const MidstPrefixList::NameTuple& tuple) {
-                           return name == std::get<MidstPrefixList::MidstIndex::NAME>(tuple);
-                         });
-  if (Itr != m_names.end()) {
-    return std::get<MidstPrefixList::MidstIndex::ANCHOR>(*Itr);
-  }
-  return INVALID_NAME2;
-}
-
-ndn::Name&
-MidstPrefixList::getAnchor(const ndn::Name& name)
-{
-  auto Itr = std::find_if(m_names.begin(), m_names.end(),
-                         [&] (const MidstPrefixList::NameTuple& tuple) {
-                           return name == std::get<MidstPrefixList::MidstIndex::NAME>(tuple);
-                         });
-  if (Itr != m_names.end()) {
-    return std::get<MidstPrefixList::MidstIndex::ANCHOR>(*Itr);
+  auto it = m_index.find(name);
+  if (it != m_index.end()) {
+    return m_anchors[it->second];
   }
-  return INVALID_NAME1;
+  return INVALID_NAME;
 }
 
 uint32_t
 MidstPrefixList::getSeqNo(const ndn::Name& name) const
 {
-  auto Itr = std::find_if(m_names.begin(), m_names.end(),
-                         [&] (const MidstPrefixList::NameTuple& tuple) {
-                           return name == std::get<MidstPrefixList::MidstIndex::NAME>(tuple);
-                         });
-  if (Itr != m_names.end()) {
-    return std::get<MidstPrefixList::MidstIndex::SEQNO>(*Itr);
+  auto it = m_index.find(name);
+  if (it != m_index.end()) {
+    return m_seqNos[it->second];
   }
   return 500; // I would prefer an INVALID value
 }
@@ -267,11 +272,11 @@ MidstPrefixList::getSeqNo(const ndn::Name& name) const
 std::ostream&
 operator<<(std::ostream& os, const MidstPrefixList& list) {
   os << "MIDST prefix list: {\n";
-  for (const auto& name : list.getNames()) {
-    os << name << "\n"
-       << "Distance: " << list.getDistance(name) << "\n"
-       << "Anchor: " << list.getAnchor(name) <<  "\n"
-       << "Sequence Number: " << list.getSeqNo(name) <<  "\n";
+  for (const auto& entry : list) {
+    os << entry.name << "\n"
+       << "Distance: " << entry.distance << "\n"
+       << "Anchor: " << entry.anchor <<  "\n"
+       << "Sequence Number: " << entry.seqNo <<  "\n";
   }
   os << "}" << std::endl;
   return os;
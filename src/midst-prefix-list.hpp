@@ -23,11 +23,21 @@
 
 #include <list>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <boost/cstdint.hpp>
 #include <ndn-cxx/name.hpp>
 
 
 namespace nlsr {
+
+/*! \brief The names announced in a MIDST LSA, each with its distance, anchor
+ *  router and sequence number.
+ *
+ * Each field is kept in its own array, so the encoder and the route
+ * calculation walk contiguous memory, and a hashed index maps a name to its
+ * position. Iterating the list yields Entry views into the arrays.
+ */
 class MidstPrefixList
 {
 public:
@@ -39,6 +49,69 @@ public:
     SEQNO
   };
 
+  /*! \brief A view of one entry, valid until the list is modified.
+   */
+  struct Entry
+  {
+    const ndn::Name& name;
+    double distance;
+    const ndn::Name& anchor;
+    uint32_t seqNo;
+  };
+
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Entry;
+
+    const_iterator(const MidstPrefixList& list, size_t pos)
+      : m_list(&list)
+      , m_pos(pos)
+    {
+    }
+
+    Entry
+    operator*() const
+    {
+      return m_list->at(m_pos);
+    }
+
+    const_iterator&
+    operator++()
+    {
+      ++m_pos;
+      return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    {
+      const_iterator it = *this;
+      ++m_pos;
+      return it;
+    }
+
+    bool
+    operator==(const const_iterator& other) const
+    {
+      return m_list == other.m_list && m_pos == other.m_pos;
+    }
+
+    bool
+    operator!=(const const_iterator& other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    const MidstPrefixList* m_list;
+    size_t m_pos;
+  };
+
   MidstPrefixList();
 
   MidstPrefixList(const std::initializer_list<ndn::Name>& names);
@@ -49,13 +122,14 @@ public:
   MidstPrefixList(const ContainerType& names)
   {
     for (const auto& elem : names) {
-      m_names.push_back(NameTuple{elem, 0, {""}, 0});
+      insert(elem, 0, {""}, 0);
     }
   }
 
   ~MidstPrefixList();
 
-  /*! \brief inserts name into NamePrefixList
+  /*! \brief inserts name into NamePrefixList, replacing the data of an
+      existing entry.
       \retval true If the name was successfully inserted.
       \retval false If the name could not be inserted.
    */
@@ -63,12 +137,17 @@ public:
   insert(const ndn::Name& name, const double distance,
          const ndn::Name& anchor, const uint32_t seqNo);
   /*! \brief removes name from NamePrefixList
+
+      The last entry takes the place of the removed one, call sort()
+      afterwards if the order matters.
       \retval true If the name is removed
       \retval false If the name failed to be removed.
    */
   bool
   remove(const ndn::Name& name);
 
+  /*! \brief Sorts the entries by name.
+   */
   void
   sort();
 
@@ -78,15 +157,50 @@ public:
     return m_names.size();
   }
 
-  void
-  setExtraDistance(double distance) const;
+  bool
+  empty() const
+  {
+    return m_names.empty();
+  }
 
+  const_iterator
+  begin() const
+  {
+    return const_iterator(*this, 0);
+  }
+
+  const_iterator
+  end() const
+  {
+    return const_iterator(*this, m_names.size());
+  }
+
+  Entry
+  at(size_t pos) const
+  {
+    return Entry{m_names[pos], m_distances[pos], m_anchors[pos], m_seqNos[pos]};
+  }
+
+  /*! \brief Returns the position of \p name, or size() if it is not in the list.
+   */
+  size_t
+  find(const ndn::Name& name) const
+  {
+    auto it = m_index.find(name);
+    return it == m_index.end() ? m_names.size() : it->second;
+  }
+
+  /*! \brief Encodes the list with \p extraDistance added to every distance.
+
+      Encoding does not modify the list, so one list can be encoded for
+      several neighbors at once.
+   */
   template<ndn::encoding::Tag TAG>
   size_t
-  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+  wireEncode(ndn::EncodingImpl<TAG>& block, double extraDistance = 0) const;
 
-  const ndn::Block&
-  wireEncode() const;
+  ndn::Block
+  wireEncode(double extraDistance = 0) const;
 
   void
   wireDecode(const ndn::Block& wire);
@@ -103,31 +217,27 @@ public:
   const ndn::Name&
   getAnchor(const ndn::Name& name) const;
 
-  ndn::Name&
-  getAnchor(const ndn::Name& name);
-
   uint32_t
   getSeqNo(const ndn::Name& name) const;
 
 private:
-  /*! Obtain an iterator to the entry matching name.
-
-    \note We could do this quite easily inline with a lambda, but this
-    is slightly more efficient.
-   */
-  std::vector<NameTuple>::iterator
-  get(const ndn::Name& name);
-
-  ndn::Name INVALID_NAME1;
-  const ndn::Name INVALID_NAME2;
+  void
+  reindex();
 
-  std::vector<NameTuple> m_names;
+  static const ndn::Name INVALID_NAME;
 
-  mutable double extraDistance;
-  mutable ndn::Block m_wire;
+  std::vector<ndn::Name> m_names;
+  std::vector<double> m_distances;
+  std::vector<ndn::Name> m_anchors;
+  std::vector<uint32_t> m_seqNos;
+  // name => position in the arrays
+  std::unordered_map<ndn::Name, size_t> m_index;
 };
 
-NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(MidstPrefixList);
+extern template size_t
+MidstPrefixList::wireEncode<ndn::encoding::EncoderTag>(ndn::EncodingBuffer&, double) const;
+extern template size_t
+MidstPrefixList::wireEncode<ndn::encoding::EstimatorTag>(ndn::EncodingEstimator&, double) const;
 
 std::ostream&
 operator<<(std::ostream& os, const MidstPrefixList& list);
@@ -135,4 +245,3 @@ operator<<(std::ostream& os, const MidstPrefixList& list);
 } // namespace nlsr
 
 #endif // NLSR_MIDST_PREFIX_LIST_HPP
-
@@ -25,6 +25,7 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <unordered_map>
 #include <unistd.h>
 
 #include <ndn-cxx/net/face-uri.hpp>
@@ -67,7 +68,7 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
         }
       }))
   , m_dispatcher(m_face, keyChain)
-  , m_datasetHandler(m_dispatcher, m_lsdb, m_routingTable)
+  , m_datasetHandler(m_dispatcher, m_lsdb, m_routingTable, m_adjacencyList)
   , m_controller(m_face, keyChain)
   , m_faceDatasetController(m_face, keyChain)
   , m_prefixUpdateProcessor(m_dispatcher,
@@ -78,7 +79,7 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_nfdRibCommandProcessor(m_dispatcher,
       m_namePrefixList,
       m_lsdb)
-  , m_statsCollector(m_lsdb, m_helloProtocol)
+  , m_statsCollector(m_lsdb, m_helloProtocol, m_routingTable)
   , m_faceMonitor(m_face)
 {
   NLSR_LOG_DEBUG("Initializing Nlsr");
@@ -116,41 +117,52 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
       neighbor.setLinkCost(0);
     }
   }
+
+  // Start from the LSDB saved before the last shutdown, if any, rather than
+  // waiting for sync to rediscover every LSA
+  m_lsdb.loadSnapshot();
 }
 
 void
 Nlsr::registerStrategyForCerts(const ndn::Name& originRouter)
 {
-  for (const ndn::Name& router : m_strategySetOnRouters) {
-    if (router == originRouter) {
-      // Have already set strategy for this router's certs once
-      return;
-    }
+  if (!m_strategySetOnRouters.insert(originRouter).second) {
+    // Have already set strategy for this router's certs once
+    return;
   }
 
-  m_strategySetOnRouters.push_back(originRouter);
-
   ndn::Name routerKey(originRouter);
   routerKey.append(ndn::security::Certificate::KEY_COMPONENT);
   ndn::Name instanceKey(originRouter);
   instanceKey.append("nlsr").append(ndn::security::Certificate::KEY_COMPONENT);
 
-  m_fib.setStrategy(routerKey, Fib::BEST_ROUTE_V2_STRATEGY, 0);
-  m_fib.setStrategy(instanceKey, Fib::BEST_ROUTE_V2_STRATEGY, 0);
+  setStrategyForCerts(routerKey);
+  setStrategyForCerts(instanceKey);
+
+  static const auto routerTag = ndn::Name::Component::fromEscapedString("%C1.Router");
 
   ndn::Name siteKey;
   for (size_t i = 0; i < originRouter.size(); ++i) {
-    if (originRouter[i].toUri() == "%C1.Router") {
+    if (originRouter[i] == routerTag) {
       break;
     }
     siteKey.append(originRouter[i]);
   }
+  // The site KEY and operator prefixes are shared by all routers of the site
   ndn::Name opPrefix(siteKey);
   siteKey.append(ndn::security::Certificate::KEY_COMPONENT);
-  m_fib.setStrategy(siteKey, Fib::BEST_ROUTE_V2_STRATEGY, 0);
+  setStrategyForCerts(siteKey);
 
   opPrefix.append(std::string("%C1.Operator"));
-  m_fib.setStrategy(opPrefix, Fib::BEST_ROUTE_V2_STRATEGY, 0);
+  setStrategyForCerts(opPrefix);
+}
+
+void
+Nlsr::setStrategyForCerts(const ndn::Name& prefix)
+{
+  if (m_strategySetOnPrefixes.insert(prefix).second) {
+    m_fib.setStrategy(prefix, Fib::BEST_ROUTE_V2_STRATEGY, 0);
+  }
 }
 
 void
@@ -193,7 +205,7 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
       if (adjacent != m_adjacencyList.end()) {
         NLSR_LOG_DEBUG("Face to " << adjacent->getName() << " with face id: " << faceId << " destroyed");
 
-        adjacent->setFaceId(0);
+        m_adjacencyList.setFaceId(adjacent, 0);
 
         // Only trigger an Adjacency LSA build if this node is changing
         // from ACTIVE to INACTIVE since this rebuild will effectively
@@ -249,7 +261,7 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
       {
         NLSR_LOG_DEBUG("Face creation event matches neighbor: " << adjacent->getName()
                         << ". New Face ID: " << faceId << ". Registering prefixes.");
-        adjacent->setFaceId(faceId);
+        m_adjacencyList.setFaceId(adjacent, faceId);
 
         registerAdjacencyPrefixes(*adjacent, ndn::time::milliseconds::max());
 
@@ -278,32 +290,41 @@ Nlsr::processFaceDataset(const std::vector<ndn::nfd::FaceStatus>& faces)
 {
   NLSR_LOG_DEBUG("Processing face dataset");
 
+  // Index the dataset by remote URI. NFD reports it in canonical form, as are
+  // the neighbor FaceUris in nlsr.conf. If several Faces share a URI, the
+  // first one wins.
+  std::unordered_map<std::string, uint64_t> faceIdByUri;
+  faceIdByUri.reserve(faces.size());
+  for (const auto& faceStatus : faces) {
+    faceIdByUri.emplace(faceStatus.getRemoteUri(), faceStatus.getFaceId());
+  }
+
   // Iterate over each neighbor listed in nlsr.conf
-  for (auto&& adjacent : m_adjacencyList.getAdjList()) {
-
-    const std::string& faceUriString = adjacent.getFaceUri().toString();
-    // Check the list of FaceStatus objects we got for a match
-    for (const auto& faceStatus : faces) {
-      // Set the adjacency FaceID if we find a URI match and it was
-      // previously unset. Change the boolean to true.
-      if (adjacent.getFaceId() == 0 && faceUriString == faceStatus.getRemoteUri()) {
-        NLSR_LOG_DEBUG("FaceUri: " << faceStatus.getRemoteUri() <<
-                   " FaceId: "<< faceStatus.getFaceId());
-        adjacent.setFaceId(faceStatus.getFaceId());
-        // Register the prefixes for each neighbor
-        this->registerAdjacencyPrefixes(adjacent, ndn::time::milliseconds::max());
-      }
+  std::vector<AdjacencyList::const_iterator> newAdjacents;
+  auto& adjList = m_adjacencyList.getAdjList();
+  for (auto adjacent = adjList.begin(); adjacent != adjList.end(); ++adjacent) {
+    if (adjacent->getFaceId() != 0) {
+      continue;
     }
-    // If this adjacency has no information in this dataset, then one
-    // of two things is happening: 1. NFD is starting slowly and this
-    // Face wasn't ready yet, or 2. NFD is configured
-    // incorrectly and this Face isn't available.
-    if (adjacent.getFaceId() == 0) {
-      NLSR_LOG_WARN("The adjacency " << adjacent.getName() <<
+
+    auto face = faceIdByUri.find(adjacent->getFaceUri().toString());
+    if (face != faceIdByUri.end()) {
+      NLSR_LOG_DEBUG("FaceUri: " << face->first << " FaceId: " << face->second);
+      m_adjacencyList.setFaceId(adjacent, face->second);
+      newAdjacents.push_back(adjacent);
+    }
+    else {
+      // If this adjacency has no information in this dataset, then one
+      // of two things is happening: 1. NFD is starting slowly and this
+      // Face wasn't ready yet, or 2. NFD is configured
+      // incorrectly and this Face isn't available.
+      NLSR_LOG_WARN("The adjacency " << adjacent->getName() <<
                 " has no Face information in this dataset.");
     }
   }
 
+  registerAdjacencyPrefixes(newAdjacents, ndn::time::milliseconds::max());
+
   scheduleDatasetFetch();
 }
 
@@ -322,6 +343,27 @@ Nlsr::registerAdjacencyPrefixes(const Adjacent& adj, ndn::time::milliseconds tim
                        ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
 }
 
+void
+Nlsr::registerAdjacencyPrefixes(const std::vector<AdjacencyList::const_iterator>& adjacents,
+                                ndn::time::milliseconds timeout)
+{
+  if (adjacents.empty()) {
+    return;
+  }
+  NLSR_LOG_DEBUG("Registering prefixes for " << adjacents.size() << " neighbors");
+
+  // The neighbor prefixes go out first, so that every neighbor can be sent
+  // Hello Interests without waiting for the LSA prefix registrations
+  for (const auto& adjacent : adjacents) {
+    m_fib.registerPrefix(adjacent->getName(), adjacent->getFaceUri(), adjacent->getLinkCost(),
+                         timeout, ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+  }
+  for (const auto& adjacent : adjacents) {
+    m_fib.registerPrefix(m_confParam.getLsaPrefix(), adjacent->getFaceUri(),
+                         adjacent->getLinkCost(), timeout, ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+  }
+}
+
 void
 Nlsr::onFaceDatasetFetchTimeout(uint32_t code,
                                 const std::string& msg,
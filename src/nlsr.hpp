@@ -51,6 +51,8 @@
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 #include <ndn-cxx/mgmt/nfd/control-response.hpp>
 
+#include <unordered_set>
+
 namespace nlsr {
 
 class Nlsr
@@ -79,10 +81,19 @@ public:
     return m_fib;
   }
 
-private:
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Sets best-route for the certificate prefixes of \p originRouter.
+   *
+   * Only the KEY and operator prefixes are set, so that choices made by the
+   * operator on other prefixes are left alone. Each prefix is set only once.
+   */
   void
   registerStrategyForCerts(const ndn::Name& originRouter);
 
+private:
+  void
+  setStrategyForCerts(const ndn::Name& prefix);
+
   /*! \brief Add top level prefixes for Dispatcher
    *
    * All dispatcher-related sub-prefixes *must* be registered before sub-prefixes
@@ -137,6 +148,16 @@ private:
   void
   registerAdjacencyPrefixes(const Adjacent& adj, ndn::time::milliseconds timeout);
 
+  /*! \brief Registers NLSR-specific prefixes for several neighbors at once.
+   * \sa Nlsr::processFaceDataset
+   *
+   * All registration commands are sent back to back without waiting for
+   * replies, so NFD processes them as one pipelined batch.
+   */
+  void
+  registerAdjacencyPrefixes(const std::vector<AdjacencyList::const_iterator>& adjacents,
+                            ndn::time::milliseconds timeout);
+
   /*! \brief Registers the prefix
    */
   void
@@ -170,7 +191,8 @@ private:
   AdjacencyList& m_adjacencyList;
   NamePrefixList& m_namePrefixList;
   MidstPrefixList& m_midstPrefixList;
-  std::vector<ndn::Name> m_strategySetOnRouters;
+  std::unordered_set<ndn::Name> m_strategySetOnRouters;
+  std::unordered_set<ndn::Name> m_strategySetOnPrefixes;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Fib m_fib;
@@ -22,6 +22,7 @@
 #include "dataset-interest-handler.hpp"
 #include "nlsr.hpp"
 #include "logger.hpp"
+#include "tlv-nlsr.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-response.hpp>
 #include <ndn-cxx/util/regex.hpp>
@@ -34,12 +35,15 @@ const ndn::PartialName ADJACENCIES_DATASET = ndn::PartialName("lsdb/adjacencies"
 const ndn::PartialName COORDINATES_DATASET = ndn::PartialName("lsdb/coordinates");
 const ndn::PartialName NAMES_DATASET = ndn::PartialName("lsdb/names");
 const ndn::PartialName RT_DATASET = ndn::PartialName("routing-table");
+const ndn::PartialName NEIGHBORS_DATASET = ndn::PartialName("neighbors");
 
 DatasetInterestHandler::DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher,
                                                const Lsdb& lsdb,
-                                               const RoutingTable& rt)
+                                               const RoutingTable& rt,
+                                               const AdjacencyList& adjacencies)
   : m_lsdb(lsdb)
   , m_routingTable(rt)
+  , m_adjacencies(adjacencies)
 {
   dispatcher.addStatusDataset(ADJACENCIES_DATASET,
     ndn::mgmt::makeAcceptAllAuthorization(),
@@ -53,6 +57,9 @@ DatasetInterestHandler::DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher
   dispatcher.addStatusDataset(RT_DATASET,
     ndn::mgmt::makeAcceptAllAuthorization(),
     std::bind(&DatasetInterestHandler::publishRtStatus, this, _1, _2, _3));
+  dispatcher.addStatusDataset(NEIGHBORS_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishNeighborStatus, this, _1, _2, _3));
 }
 
 template <typename T>
@@ -77,4 +84,21 @@ DatasetInterestHandler::publishRtStatus(const ndn::Name& topPrefix, const ndn::I
   context.end();
 }
 
+void
+DatasetInterestHandler::publishNeighborStatus(const ndn::Name& topPrefix,
+                                              const ndn::Interest& interest,
+                                              ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  for (const auto& adjacent : m_adjacencies.getAdjList()) {
+    ndn::Block status(ndn::tlv::nlsr::NeighborStatus);
+    status.push_back(adjacent.getName().wireEncode());
+    status.push_back(ndn::encoding::makeNonNegativeIntegerBlock(ndn::tlv::nlsr::HelloInterval,
+                                                               adjacent.getHelloInterval().count()));
+    status.encode();
+    context.append(status);
+  }
+  context.end();
+}
+
 } // namespace nlsr
@@ -34,6 +34,7 @@
 #include "route/routing-table-entry.hpp"
 #include "route/routing-table.hpp"
 #include "route/nexthop-list.hpp"
+#include "adjacency-list.hpp"
 #include "lsdb.hpp"
 #include "logger.hpp"
 
@@ -68,7 +69,8 @@ public:
 
   DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher,
                          const Lsdb& lsdb,
-                         const RoutingTable& rt);
+                         const RoutingTable& rt,
+                         const AdjacencyList& adjacencies);
 
 private:
   /*! \brief provide routing-table dataset
@@ -77,6 +79,15 @@ private:
   publishRtStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                   ndn::mgmt::StatusDatasetContext& context);
 
+  /*! \brief provide neighbor status dataset
+
+      Each neighbor is encoded as a NeighborStatus block holding its name and
+      its current hello interval in seconds.
+   */
+  void
+  publishNeighborStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                        ndn::mgmt::StatusDatasetContext& context);
+
   /*! \brief provide LSA status dataset
    */
   template <typename T>
@@ -87,6 +98,7 @@ private:
 private:
   const Lsdb& m_lsdb;
   const RoutingTable& m_routingTable;
+  const AdjacencyList& m_adjacencies;
 };
 
 } // namespace nlsr
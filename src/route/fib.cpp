@@ -35,6 +35,7 @@ INIT_LOGGER(route.Fib);
 
 const std::string Fib::MULTICAST_STRATEGY("ndn:/localhost/nfd/strategy/multicast");
 const std::string Fib::BEST_ROUTE_V2_STRATEGY("ndn:/localhost/nfd/strategy/best-route");
+constexpr size_t Fib::STRATEGY_COMMAND_WINDOW;
 
 Fib::Fib(ndn::Face& face, ndn::Scheduler& scheduler, AdjacencyList& adjacencyList,
          ConfParameter& conf, ndn::security::KeyChain& keyChain)
@@ -220,7 +221,7 @@ Fib::onRegistrationSuccess(const ndn::nfd::ControlParameters& param,
 
   auto adjacent = m_adjacencyList.findAdjacent(faceUri);
   if (adjacent != m_adjacencyList.end()) {
-    adjacent->setFaceId(param.getFaceId());
+    m_adjacencyList.setFaceId(adjacent, param.getFaceId());
   }
   onPrefixRegistrationSuccess(param.getName());
 }
@@ -283,10 +284,25 @@ Fib::setStrategy(const ndn::Name& name, const std::string& strategy, uint32_t co
     .setName(name)
     .setStrategy(strategy);
 
-  m_controller.start<ndn::nfd::StrategyChoiceSetCommand>(parameters,
-                                                         std::bind(&Fib::onSetStrategySuccess, this, _1),
-                                                         std::bind(&Fib::onSetStrategyFailure, this, _1,
-                                                                   parameters, count));
+  m_strategyCommands.emplace_back(parameters, count);
+  sendStrategyCommands();
+}
+
+void
+Fib::sendStrategyCommands()
+{
+  while (!m_strategyCommands.empty() &&
+         m_nOutstandingStrategyCommands < STRATEGY_COMMAND_WINDOW) {
+    ndn::nfd::ControlParameters parameters = m_strategyCommands.front().first;
+    uint32_t count = m_strategyCommands.front().second;
+    m_strategyCommands.pop_front();
+
+    ++m_nOutstandingStrategyCommands;
+    m_controller.start<ndn::nfd::StrategyChoiceSetCommand>(parameters,
+                                                           std::bind(&Fib::onSetStrategySuccess, this, _1),
+                                                           std::bind(&Fib::onSetStrategyFailure, this, _1,
+                                                                     parameters, count));
+  }
 }
 
 void
@@ -294,6 +310,8 @@ Fib::onSetStrategySuccess(const ndn::nfd::ControlParameters& commandSuccessResul
 {
   NLSR_LOG_DEBUG("Successfully set strategy choice: " << commandSuccessResult.getStrategy() <<
                  " for name: " << commandSuccessResult.getName());
+  --m_nOutstandingStrategyCommands;
+  sendStrategyCommands();
 }
 
 void
@@ -303,9 +321,13 @@ Fib::onSetStrategyFailure(const ndn::nfd::ControlResponse& response,
 {
   NLSR_LOG_DEBUG("Failed to set strategy choice: " << parameters.getStrategy() <<
                  " for name: " << parameters.getName());
+  --m_nOutstandingStrategyCommands;
   if (count < 3) {
     setStrategy(parameters.getName(), parameters.getStrategy().toUri(), count + 1);
   }
+  else {
+    sendStrategyCommands();
+  }
 }
 
 void
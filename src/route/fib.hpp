@@ -29,6 +29,8 @@
 #include <ndn-cxx/util/scheduler.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include <deque>
+
 namespace nlsr {
 
 struct FibEntry {
@@ -132,6 +134,11 @@ public:
                  uint64_t flags,
                  uint8_t times);
 
+  /*! \brief Sets the forwarding strategy for \p name in NFD.
+   *
+   * The StrategyChoiceSet commands are queued, and at most
+   * STRATEGY_COMMAND_WINDOW of them are outstanding at a time.
+   */
   void
   setStrategy(const ndn::Name& name, const std::string& strategy, uint32_t count);
 
@@ -215,6 +222,11 @@ private:
   void
   refreshEntry(const ndn::Name& name, afterRefreshCallback refreshCb);
 
+  /*! \brief Sends queued strategy choice commands while the window allows.
+   */
+  void
+  sendStrategyCommands();
+
 public:
   static const std::string MULTICAST_STRATEGY;
   static const std::string BEST_ROUTE_V2_STRATEGY;
@@ -228,6 +240,12 @@ private:
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::map<ndn::Name, FibEntry> m_table;
 
+  /*! Queued strategy choice commands, with how many times each has failed */
+  std::deque<std::pair<ndn::nfd::ControlParameters, uint32_t>> m_strategyCommands;
+  size_t m_nOutstandingStrategyCommands = 0;
+
+  static constexpr size_t STRATEGY_COMMAND_WINDOW = 16;
+
 private:
   AdjacencyList& m_adjacencyList;
   ConfParameter& m_confParameter;
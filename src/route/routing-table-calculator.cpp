@@ -30,6 +30,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <ndn-cxx/util/logger.hpp>
 #include <cmath>
+#include <set>
 
 namespace nlsr {
 
@@ -640,126 +641,182 @@ HyperbolicRoutingCalculator::addNextHop(ndn::Name dest, std::string faceUri,
   }
 }
 
-const ndn::optional<ndn::Name> DvRoutingCalculator::UNKNOWN_HROUTER = "";
-
 void
-DvRoutingCalculator::calculatePath(Map& map, RoutingTable& rtable,
-                                   AdjacencyList& adjList,
-                                   Lsdb& lsdb)
+DvRoutingCalculator::calculatePath(RoutingTable& rtable, AdjacencyList& adjList, Lsdb& lsdb)
 {
   NLSR_LOG_TRACE("DvRoutingCalculator::calculatePath Called");
 
-  ndn::optional<int32_t> thisRouter = map.getMappingNoByRouterName(m_thisRouterName);
-
-  // Initialize the distance vector
-  initDistanceVector(thisRouter);
-  printDistanceVector();
+  m_linkCosts.clear();
+  m_ribIn.clear();
+  m_routes.clear();
 
-  fillDisVecDirectNeighborsDistance(map, lsdb);
-  printDistanceVector();
+  auto ownAdjLsa = lsdb.findLsa<AdjLsa>(m_thisRouterName);
+  if (ownAdjLsa != nullptr) {
+    for (const auto& adj : ownAdjLsa->getAdl().getAdjList()) {
+      m_linkCosts[adj.getName()] = adj.getLinkCost();
+    }
+  }
 
-  fillDisVecOtherNeighborsDistance(map, lsdb);
-  printDistanceVector();
+  std::set<ndn::Name> destinations;
+  for (const auto& link : m_linkCosts) {
+    destinations.insert(link.first);
+  }
 
-  // After calculating the shorter distances from this router to its
-  // neighbors, install the nexthops for this router
-  for (int32_t i=0; i<m_nRouters; i++){
-    // Do not add a next-hop to itself
-    if (i == thisRouter) {
+  auto mLsaRange = lsdb.getLsdbIterator<MidstLsa>();
+  for (auto mLsaIt = mLsaRange.first; mLsaIt != mLsaRange.second; mLsaIt++) {
+    auto mLsaPtr = std::static_pointer_cast<MidstLsa>(*mLsaIt);
+    if (mLsaPtr->getOriginRouter() == m_thisRouterName) {
       continue;
     }
 
-    ndn::optional<ndn::Name>  dest = map.getRouterNameByMappingNo(i);
-    ndn::optional<ndn::Name> nhRtr = std::get<DvTupleIndex::NEXTHOP>(distance_vector[i]);
-    std::string        nextHopFace = adjList.getAdjacent(*nhRtr).getFaceUri().toString();
-    
-    addNextHop(*dest, nextHopFace,
-               std::get<DvTupleIndex::DISTANCE>(distance_vector[i]), rtable);
+    RibIn& ribIn = m_ribIn[mLsaPtr->getOriginRouter()];
+    ribIn = makeRibIn(*mLsaPtr);
+    for (const auto& entry : ribIn) {
+      destinations.insert(entry.first);
+    }
   }
+
+  for (const auto& dest : destinations) {
+    evaluate(dest);
+    installRoute(dest, rtable, adjList);
+  }
+  m_isInitialized = true;
+
+  writeLog();
 }
 
-void
-DvRoutingCalculator::initDistanceVector(ndn::optional<int32_t> thisRouter)
+bool
+DvRoutingCalculator::updateNeighbor(const ndn::Name& neighbor, const MidstLsa* lsa,
+                                    RoutingTable& rtable, AdjacencyList& adjList)
 {
-  distance_vector.clear();
+  if (!m_isInitialized) {
+    return false;
+  }
+
+  RibIn newRibIn;
+  if (lsa != nullptr) {
+    newRibIn = makeRibIn(*lsa);
+  }
 
-  for (int32_t i=0; i<m_nRouters; i++) {
-    if (i == thisRouter) {
-      distance_vector.emplace_back(0, UNKNOWN_HROUTER);
+  // Only the anchors whose advertised distance changed can change route
+  std::set<ndn::Name> changed;
+  auto ribInIt = m_ribIn.find(neighbor);
+  if (ribInIt != m_ribIn.end()) {
+    for (const auto& entry : ribInIt->second) {
+      auto it = newRibIn.find(entry.first);
+      if (it == newRibIn.end() || it->second != entry.second) {
+        changed.insert(entry.first);
+      }
     }
-    else {
-      distance_vector.emplace_back(Adjacent::NON_ADJACENT_COST, UNKNOWN_HROUTER);
+    for (const auto& entry : newRibIn) {
+      if (ribInIt->second.count(entry.first) == 0) {
+        changed.insert(entry.first);
+      }
+    }
+  }
+  else {
+    for (const auto& entry : newRibIn) {
+      changed.insert(entry.first);
     }
   }
-  NLSR_LOG_TRACE("Number of routers in DV = " << m_nRouters);
-}
-
-void
-DvRoutingCalculator::fillDisVecDirectNeighborsDistance(Map& map, Lsdb& lsdb)
-{
-  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
-
-  for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; lsaIt++) {
-    auto lsaPtr = std::static_pointer_cast<AdjLsa>(*lsaIt);
 
-    // Perform this operation only for direct neighbors
-    if (lsaPtr->getOriginRouter() == m_thisRouterName) {
+  if (lsa != nullptr) {
+    m_ribIn[neighbor] = std::move(newRibIn);
+  }
+  else {
+    m_ribIn.erase(neighbor);
+  }
 
-      for (const auto& adj : lsaPtr->getAdl().getAdjList()) {
-        ndn::optional<int32_t> neighRtr = map.getMappingNoByRouterName(adj.getName());
+  NLSR_LOG_DEBUG("Vector of " << neighbor << " changed " << changed.size() << " anchors");
 
-        std::get<DvTupleIndex::DISTANCE>(distance_vector[*neighRtr]) = adj.getLinkCost();
-        std::get<DvTupleIndex::NEXTHOP>(distance_vector[*neighRtr])  = adj.getName();
-      }
+  bool isRouteChanged = false;
+  for (const auto& dest : changed) {
+    if (evaluate(dest)) {
+      installRoute(dest, rtable, adjList);
+      isRouteChanged = true;
     }
   }
+  return isRouteChanged;
 }
 
-void
-DvRoutingCalculator::fillDisVecOtherNeighborsDistance(Map& map, Lsdb& lsdb)
+DvRoutingCalculator::RibIn
+DvRoutingCalculator::makeRibIn(const MidstLsa& lsa)
 {
-  auto mLsaRange = lsdb.getLsdbIterator<MidstLsa>();
+  RibIn ribIn;
+  for (const auto& entry : lsa.getNpl()) {
+    auto result = ribIn.emplace(entry.anchor, entry.distance);
+    if (!result.second && entry.distance < result.first->second) {
+      result.first->second = entry.distance;
+    }
+  }
+  return ribIn;
+}
 
-  for (auto mLsaIt = mLsaRange.first; mLsaIt != mLsaRange.second; mLsaIt++) {
-    auto mLsaPtr = std::static_pointer_cast<MidstLsa>(*mLsaIt);
+bool
+DvRoutingCalculator::evaluate(const ndn::Name& dest)
+{
+  ndn::optional<Route> best;
 
-    // Do not repeat the operations done by the direct neighbors method
-    if (mLsaPtr->getOriginRouter() == m_thisRouterName) {
-      continue;
+  if (dest != m_thisRouterName) {
+    auto link = m_linkCosts.find(dest);
+    if (link != m_linkCosts.end()) {
+      best = Route{link->second, dest};
     }
 
-    ndn::optional<int32_t> xRtr = map.getMappingNoByRouterName(mLsaPtr->getOriginRouter());
-
-    for (const auto& adj : mLsaPtr->getNpl().getNames()) {
-      double        distance = mLsaPtr->getNpl().getDistance(adj);
-      const ndn::Name anchor = mLsaPtr->getNpl().getAnchor(adj);
-      ndn::optional<int32_t> yRtr = map.getMappingNoByRouterName(anchor);
-      
-      double calc_distance = std::get<DvTupleIndex::DISTANCE>(distance_vector[*xRtr])
-                             + distance;     
-      
-      if ((std::get<DvTupleIndex::DISTANCE>(distance_vector[*yRtr]) == Adjacent::NON_ADJACENT_COST)
-          ||
-          (std::get<DvTupleIndex::DISTANCE>(distance_vector[*yRtr]) > calc_distance)) {
-        std::get<DvTupleIndex::DISTANCE>(distance_vector[*yRtr]) = calc_distance;
-        std::get<DvTupleIndex::NEXTHOP>(distance_vector[*yRtr])  = mLsaPtr->getOriginRouter();
+    for (const auto& ribIn : m_ribIn) {
+      auto neighborLink = m_linkCosts.find(ribIn.first);
+      auto entry = ribIn.second.find(dest);
+      // Vectors are only usable from current neighbors
+      if (neighborLink == m_linkCosts.end() || entry == ribIn.second.end()) {
+        continue;
+      }
+
+      double distance = neighborLink->second + entry->second;
+      // Ties go to the smaller next-hop name, independently of the hash order
+      if (!best || distance < best->distance ||
+          (distance == best->distance && ribIn.first < best->nextHop)) {
+        best = Route{distance, ribIn.first};
       }
     }
   }
+
+  auto it = m_routes.find(dest);
+  if (!best) {
+    if (it == m_routes.end()) {
+      return false;
+    }
+    m_routes.erase(it);
+    return true;
+  }
+
+  if (it != m_routes.end() && it->second.distance == best->distance &&
+      it->second.nextHop == best->nextHop) {
+    return false;
+  }
+  m_routes[dest] = *best;
+  return true;
 }
 
 void
-DvRoutingCalculator::addNextHop(ndn::Name destRtr, std::string faceUri,
-                                double distance, RoutingTable& rtgTable)
+DvRoutingCalculator::installRoute(const ndn::Name& dest, RoutingTable& rtable,
+                                  AdjacencyList& adjList)
 {
-  NextHop hop(faceUri, distance);
+  rtable.removeRoutingTableEntry(dest);
 
-  NLSR_LOG_TRACE("Calculated " << hop << " for destination: " << destRtr);
-  rtgTable.addNextHop(destRtr, hop);
+  auto it = m_routes.find(dest);
+  if (it == m_routes.end()) {
+    NLSR_LOG_TRACE("No route to " << dest);
+    return;
+  }
+
+  NextHop hop(adjList.getAdjacent(it->second.nextHop).getFaceUri().toString(),
+              it->second.distance);
+  NLSR_LOG_TRACE("Calculated " << hop << " for destination: " << dest);
+  rtable.addNextHop(dest, hop);
 }
 
 void
-DvRoutingCalculator::printDistanceVector() const
+DvRoutingCalculator::writeLog() const
 {
   if (!ndn_cxx_getLogger().isLevelEnabled(ndn::util::LogLevel::DEBUG)) {
     return;
@@ -769,16 +826,9 @@ DvRoutingCalculator::printDistanceVector() const
   NLSR_LOG_DEBUG(" Dest | Dist | Next hop");
   NLSR_LOG_DEBUG("-------------------------------");
 
-  for(int32_t i=0; i<m_nRouters; i++) {
-    std::string line = "   ";
-    line += boost::lexical_cast<std::string>(i);
-    line += "  | ";
-    line += boost::lexical_cast<std::string>(
-            std::get<DvRoutingCalculator::DvTupleIndex::DISTANCE>(distance_vector[i]));
-    line += "  | ";
-    line += boost::lexical_cast<std::string>(
-            *std::get<DvRoutingCalculator::DvTupleIndex::NEXTHOP>(distance_vector[i]));
-    NLSR_LOG_DEBUG(line);
+  for (const auto& route : m_routes) {
+    NLSR_LOG_DEBUG("   " << route.first << "  | " << route.second.distance << "  | " <<
+                   route.second.nextHop);
   }
 }
 
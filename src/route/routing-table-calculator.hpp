@@ -26,8 +26,10 @@
 #include "lsa/adj-lsa.hpp"
 #include "lsdb.hpp"
 #include "conf-parameter.hpp"
+#include "test-access-control.hpp"
 
 #include <list>
+#include <unordered_map>
 
 namespace nlsr {
 
@@ -242,48 +244,81 @@ private:
   static const double UNKNOWN_RADIUS;
 };
 
+/*! \brief Distance-vector route computation for MIDST.
+ *
+ * A RIB-in table is kept per neighbor: the distance to each anchor in the
+ * last vector received from that neighbor. The route to an anchor goes
+ * through the neighbor with the smallest link cost plus advertised
+ * distance, or straight to the anchor if it is a neighbor and that is
+ * shorter. When one neighbor's vector changes, only the anchors whose
+ * distance in it changed are evaluated again.
+ */
 class DvRoutingCalculator
 {
 public:
-  DvRoutingCalculator(int32_t nRouters, ndn::Name thisRouterName)
-    : m_nRouters(nRouters)
-    , m_thisRouterName(thisRouterName)
+  explicit
+  DvRoutingCalculator(const ndn::Name& thisRouterName)
+    : m_thisRouterName(thisRouterName)
   {
   }
 
+  /*! \brief Rebuilds the link costs and every RIB-in from the LSDB and
+   *  installs all routes in \p rtable.
+   *
+   *  Our own adjacencies can move any route, so a change to them needs
+   *  this full computation.
+   */
   void
-  calculatePath(Map& map, RoutingTable& rtable, AdjacencyList& adjacencies,
-                Lsdb& lsdb);
+  calculatePath(RoutingTable& rtable, AdjacencyList& adjList, Lsdb& lsdb);
+
+  /*! \brief Replaces the RIB-in of \p neighbor with the vector in \p lsa
+   *  and updates the routes that changed.
+   *
+   *  \param lsa The neighbor's MIDST LSA, or nullptr if it was removed
+   *  \return whether any route in \p rtable changed
+   */
+  bool
+  updateNeighbor(const ndn::Name& neighbor, const MidstLsa* lsa,
+                 RoutingTable& rtable, AdjacencyList& adjList);
+
+  /*! \brief Whether calculatePath() has run, so that updates can be applied.
+   */
+  bool
+  isInitialized() const
+  {
+    return m_isInitialized;
+  }
 
-private:
-  void
-  initDistanceVector(ndn::optional<int32_t> thisRouter);
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  // anchor => distance advertised by the neighbor
+  using RibIn = std::unordered_map<ndn::Name, double>;
 
-  void
-  fillDisVecDirectNeighborsDistance(Map& map, Lsdb& lsdb);
+  static RibIn
+  makeRibIn(const MidstLsa& lsa);
 
-  void
-  fillDisVecOtherNeighborsDistance(Map& map, Lsdb& lsdb);
+  /*! \brief Picks the best route to \p dest from the link costs and RIB-in tables.
+   *  \return whether the route changed
+   */
+  bool
+  evaluate(const ndn::Name& dest);
 
   void
-  addNextHop(ndn::Name destRtr, std::string faceUri, double distance,
-             RoutingTable& rt);
+  installRoute(const ndn::Name& dest, RoutingTable& rtable, AdjacencyList& adjList);
 
   void
-  printDistanceVector() const;
-  
-private:
-  const int32_t    m_nRouters;
-  const ndn::Name  m_thisRouterName;
-  static const ndn::optional<ndn::Name>  UNKNOWN_HROUTER;
+  writeLog() const;
 
-  enum DvTupleIndex {
-    DISTANCE,
-    NEXTHOP
+  struct Route
+  {
+    double distance;
+    ndn::Name nextHop;
   };
-  
-  using DvTuple = std::tuple<double, ndn::optional<ndn::Name>>;
-  std::vector<DvTuple> distance_vector;
+
+  const ndn::Name m_thisRouterName;
+  std::unordered_map<ndn::Name, double> m_linkCosts;
+  std::unordered_map<ndn::Name, RibIn> m_ribIn;
+  std::unordered_map<ndn::Name, Route> m_routes;
+  bool m_isInitialized = false;
 };
 
 } // namespace nlsr
@@ -39,6 +39,11 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
   , m_isRouteCalculationScheduled(false)
   , m_confParam(confParam)
   , m_hyperbolicState(m_confParam.getHyperbolicState())
+  , m_dvCalculator(confParam.getRouterPrefix())
+  , m_routingCalcThrottle(ndn::time::milliseconds(confParam.getRoutingCalcInitialDelay()),
+                          // a zero interval must still hold back bursts of calculations
+                          std::max(m_routingCalcInterval, ndn::time::seconds(1)),
+                          ndn::time::seconds(confParam.getRoutingCalcMaxInterval()))
 {
   m_afterLsdbModified = lsdb.onLsdbModified.connect(
     [this] (std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
@@ -77,6 +82,12 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
       if (scheduleCalculation) {
         scheduleRoutingTableCalculation();
       }
+
+      // A neighbor's vector only moves the routes to the anchors it changed
+      if (type == Lsa::Type::MIDST && m_confParam.getMidstState() == MIDST_STATE_ON &&
+          lsa->getOriginRouter() != m_confParam.getRouterPrefix()) {
+        updateDvRoutes(lsa->getOriginRouter(), updateType == LsdbUpdate::REMOVED);
+      }
     }
   );
 }
@@ -89,6 +100,7 @@ RoutingTable::calculate()
 
   if (m_isRoutingTableCalculating == false) {
     m_isRoutingTableCalculating = true;
+    rtIncrementSignal(Statistics::PacketType::ROUTING_CALC);
 
     if (m_confParam.getMidstState() == MIDST_STATE_ON) {
       calculateDvRoutingTable();
@@ -108,6 +120,8 @@ RoutingTable::calculate()
     m_isRoutingTableCalculating = false;
   }
   else {
+    // Run again once the ongoing calculation is done
+    m_isRouteCalculationScheduled = false;
     scheduleRoutingTableCalculation();
   }
 }
@@ -192,31 +206,53 @@ RoutingTable::calculateDvRoutingTable()
 
   clearRoutingTable();
 
-  Map map;
-  auto lsaRange = m_lsdb.getLsdbIterator<MidstLsa>();
-  map.createFromMidstLsdb(lsaRange.first, lsaRange.second);
-  map.writeLog();
-
-  size_t nRouters = map.getMapSize();
-
-  DvRoutingCalculator calculator(nRouters, m_confParam.getRouterPrefix());
-
-  calculator.calculatePath(map, *this, m_confParam.getAdjacencyList(),
-                           m_lsdb);
+  m_dvCalculator.calculatePath(*this, m_confParam.getAdjacencyList(), m_lsdb);
 
   NLSR_LOG_DEBUG("Calling Update NPT with new Route");
   afterRoutingChange(m_rTable);
   NLSR_LOG_DEBUG(*this);
 }
 
+void
+RoutingTable::updateDvRoutes(const ndn::Name& neighbor, bool isRemoved)
+{
+  // A pending full calculation will pick up the change anyway
+  if (m_isRoutingTableCalculating || m_isRouteCalculationScheduled ||
+      !m_ownAdjLsaExist || m_lsdb.getIsBuildAdjLsaScheduled()) {
+    return;
+  }
+
+  std::shared_ptr<MidstLsa> lsa;
+  if (!isRemoved) {
+    lsa = m_lsdb.findLsa<MidstLsa>(neighbor);
+  }
+
+  if (m_dvCalculator.updateNeighbor(neighbor, lsa.get(), *this,
+                                    m_confParam.getAdjacencyList())) {
+    NLSR_LOG_DEBUG("Calling Update NPT with new Route");
+    afterRoutingChange(m_rTable);
+    NLSR_LOG_DEBUG(*this);
+  }
+}
+
 void
 RoutingTable::scheduleRoutingTableCalculation()
 {
-  if (!m_isRouteCalculationScheduled) {
-    NLSR_LOG_DEBUG("Scheduling routing table calculation in " << m_routingCalcInterval);
-    m_scheduler.schedule(m_routingCalcInterval, [this] { calculate(); });
-    m_isRouteCalculationScheduled = true;
+  rtIncrementSignal(Statistics::PacketType::ROUTING_CALC_REQUEST);
+
+  if (m_isRouteCalculationScheduled) {
+    NLSR_LOG_DEBUG("Routing table calculation already scheduled");
+    return;
   }
+
+  auto delay = m_routingCalcThrottle.next();
+  if (delay > m_routingCalcThrottle.getInitialDelay()) {
+    rtIncrementSignal(Statistics::PacketType::ROUTING_CALC_BACKOFF);
+  }
+  NLSR_LOG_DEBUG("Scheduling routing table calculation in " << delay << " (hold time " <<
+                 m_routingCalcThrottle.getCurrentHoldTime() << ")");
+  m_scheduler.schedule(delay, [this] { calculate(); });
+  m_isRouteCalculationScheduled = true;
 }
 
 static bool
@@ -271,6 +307,15 @@ RoutingTable::addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh)
   m_wire.reset();
 }
 
+void
+RoutingTable::removeRoutingTableEntry(const ndn::Name& destRouter)
+{
+  m_rTable.remove_if([&destRouter] (const RoutingTableEntry& rte) {
+    return rte.getDestination() == destRouter;
+  });
+  m_wire.reset();
+}
+
 void
 RoutingTable::clearRoutingTable()
 {
@@ -26,8 +26,10 @@
 #include "signals.hpp"
 #include "lsdb.hpp"
 #include "route/fib.hpp"
+#include "route/routing-table-calculator.hpp"
 #include "test-access-control.hpp"
 #include "route/name-prefix-table.hpp"
+#include "utility/exponential-throttle.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
 
@@ -118,11 +120,21 @@ public:
   void
   addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh);
 
+  /*! \brief Removes the routing table entry for a destination, if any.
+   */
+  void
+  removeRoutingTableEntry(const ndn::Name& destRouter);
+
   RoutingTableEntry*
   findRoutingTableEntry(const ndn::Name& destRouter);
 
   /*! \brief Schedules a calculation event in the event scheduler only
    *  if one isn't already scheduled.
+   *
+   *  The delay is throttled: an isolated change is calculated after the
+   *  routing calculation initial delay, while a burst of LSDB changes spaces the
+   *  calculations out by a hold time that starts at the routing calculation
+   *  interval and doubles up to the configured maximum.
    */
   void
   scheduleRoutingTableCalculation();
@@ -140,6 +152,12 @@ private:
   void
   calculateDvRoutingTable();
 
+  /*! \brief Applies a change in the MIDST LSA of \p neighbor to the
+   *  distance-vector routes, without a full calculation.
+   */
+  void
+  updateDvRoutes(const ndn::Name& neighbor, bool isRemoved);
+
   void
   clearRoutingTable();
 
@@ -148,6 +166,7 @@ private:
 
 public:
   AfterRoutingChange afterRoutingChange;
+  ndn::util::signal::Signal<RoutingTable, Statistics::PacketType> rtIncrementSignal;
 
 private:
   ndn::Scheduler& m_scheduler;
@@ -162,6 +181,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::util::signal::Connection m_afterLsdbModified;
   int32_t m_hyperbolicState;
   bool m_ownAdjLsaExist = false;
+  DvRoutingCalculator m_dvCalculator;
+  util::ExponentialThrottle m_routingCalcThrottle;
 };
 
 } // namespace nlsr
@@ -165,7 +165,7 @@ CertificateStore::publishCertFromCache(const ndn::Name& keyName)
 void
 CertificateStore::afterFetcherSignalEmitted(const ndn::Data& lsaSegment)
 {
-  const auto keyName = lsaSegment.getSignatureInfo().getKeyLocator().getName();
+  const auto& keyName = lsaSegment.getSignatureInfo().getKeyLocator().getName();
   if (!find(keyName)) {
     NLSR_LOG_TRACE("Publishing certificate for: " << keyName);
     publishCertFromCache(keyName);
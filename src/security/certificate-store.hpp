@@ -31,6 +31,8 @@
 #include <ndn-cxx/security/certificate.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
 
+#include <unordered_map>
+
 namespace nlsr {
 class ConfParameter;
 namespace security {
@@ -92,7 +94,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   registrationFailed(const ndn::Name& name);
 
 private:
-  typedef std::map<ndn::Name, ndn::security::Certificate> CertMap;
+  // looked up once per validated LSA segment, see afterFetcherSignalEmitted
+  typedef std::unordered_map<ndn::Name, ndn::security::Certificate> CertMap;
   CertMap m_certificates;
   ndn::Face& m_face;
   ConfParameter& m_confParam;
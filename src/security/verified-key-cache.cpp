@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "verified-key-cache.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
+
+namespace nlsr {
+namespace security {
+
+INIT_LOGGER(VerifiedKeyCache);
+
+const ndn::time::seconds VerifiedKeyCache::DEFAULT_MAX_LIFETIME = ndn::time::hours(1);
+
+VerifiedKeyCache::VerifiedKeyCache(ndn::security::Validator& validator,
+                                   ndn::time::seconds maxLifetime)
+  : m_validator(validator)
+  , m_maxLifetime(maxLifetime)
+{
+}
+
+void
+VerifiedKeyCache::validate(const ndn::Data& data, const ndn::Name& context,
+                           const ndn::security::DataValidationSuccessCallback& successCb,
+                           const ndn::security::DataValidationFailureCallback& failureCb)
+{
+  auto kl = data.getKeyLocator();
+  if (kl && kl->getType() == ndn::tlv::Name) {
+    const auto* cert = find(context, kl->getName());
+    if (cert != nullptr) {
+      if (ndn::security::verifySignature(data, *cert)) {
+        ++m_nHits;
+        NLSR_LOG_TRACE("Verified " << data.getName() << " with cached key " << cert->getKeyName());
+        successCb(data);
+        return;
+      }
+
+      // The signature does not match the key the cache vouches for, let the
+      // Validator have the final word and forget what we had.
+      NLSR_LOG_DEBUG("Cached key " << cert->getKeyName() << " failed to verify " << data.getName());
+      m_entries.erase({context, cert->getKeyName()});
+    }
+  }
+
+  ++m_nMisses;
+  m_validator.validate(data,
+                       [this, context, successCb] (const ndn::Data& data) {
+                         onValidated(data, context, successCb);
+                       },
+                       failureCb);
+}
+
+void
+VerifiedKeyCache::onValidated(const ndn::Data& data, const ndn::Name& context,
+                              const ndn::security::DataValidationSuccessCallback& successCb)
+{
+  auto kl = data.getKeyLocator();
+  if (kl && kl->getType() == ndn::tlv::Name) {
+    insert(context, kl->getName());
+  }
+  successCb(data);
+}
+
+const ndn::security::Certificate*
+VerifiedKeyCache::find(const ndn::Name& context, const ndn::Name& keyLocatorName)
+{
+  bool isCertName = ndn::security::Certificate::isValidName(keyLocatorName);
+  ndn::Name keyName = isCertName ? ndn::security::extractKeyNameFromCertName(keyLocatorName)
+                                 : keyLocatorName;
+
+  auto it = m_entries.find({context, keyName});
+  if (it == m_entries.end()) {
+    return nullptr;
+  }
+
+  if (ndn::time::system_clock::now() >= it->second.expirationTime) {
+    NLSR_LOG_TRACE("Cached key " << keyName << " for " << context << " has expired");
+    m_entries.erase(it);
+    return nullptr;
+  }
+
+  if (isCertName && it->second.certificate.getName() != keyLocatorName) {
+    return nullptr;
+  }
+
+  return &it->second.certificate;
+}
+
+void
+VerifiedKeyCache::insert(const ndn::Name& context, const ndn::Name& keyLocatorName)
+{
+  ndn::Interest certInterest(keyLocatorName);
+  certInterest.setCanBePrefix(true);
+
+  const auto* cert = m_validator.findTrustedCert(certInterest);
+  if (cert == nullptr) {
+    NLSR_LOG_TRACE("No trusted certificate for " << keyLocatorName << ", not caching");
+    return;
+  }
+
+  auto now = ndn::time::system_clock::now();
+  auto expirationTime = std::min(now + m_maxLifetime,
+                                 cert->getValidityPeriod().getPeriod().second);
+  if (expirationTime <= now) {
+    return;
+  }
+
+  Entry& entry = m_entries[{context, cert->getKeyName()}];
+  ndn::Name certificateDigest = cert->getFullName();
+  if (entry.certificateDigest != certificateDigest) {
+    NLSR_LOG_DEBUG("Caching key " << cert->getKeyName() << " for " << context);
+    entry.certificate = *cert;
+    entry.certificateDigest = std::move(certificateDigest);
+  }
+  entry.expirationTime = expirationTime;
+}
+
+void
+VerifiedKeyCache::clear()
+{
+  m_entries.clear();
+}
+
+} // namespace security
+} // namespace nlsr
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_VERIFIED_KEY_CACHE_HPP
+#define NLSR_VERIFIED_KEY_CACHE_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/security/certificate.hpp>
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <map>
+
+namespace nlsr {
+namespace security {
+
+/*! \brief Remembers signing keys whose certificate chain has been validated.
+ *
+ * The first packet signed by a key goes through the full Validator, i.e. the
+ * trust schema rules and the certificate chain. If it passes, the signer's
+ * certificate is cached together with the name prefix (context) the packet was
+ * validated under, e.g. /<neighbor>/NLSR/INFO/<router> for hello Data. Later
+ * packets under the same context that are signed by the same key only need one
+ * signature check against the cached certificate.
+ *
+ * Entries are keyed by (context, key name) and record the certificate digest
+ * they were validated against. An entry lives until the certificate expires or
+ * until the configured maximum lifetime elapses, whichever comes first.
+ */
+class VerifiedKeyCache
+{
+public:
+  explicit
+  VerifiedKeyCache(ndn::security::Validator& validator,
+                   ndn::time::seconds maxLifetime = DEFAULT_MAX_LIFETIME);
+
+  /*! \brief Validate \p data, trying the cached key for \p context first.
+   *
+   * On a cache hit only the signature of \p data is verified. On a miss, or if
+   * the cached key does not verify the signature, the packet is handed to the
+   * Validator and the cache is populated if validation succeeds.
+   *
+   * \param context Name prefix shared by all packets that the signer is
+   *        allowed to produce under the trust schema, e.g. /<neighbor>/NLSR/INFO/<router>
+   */
+  void
+  validate(const ndn::Data& data, const ndn::Name& context,
+           const ndn::security::DataValidationSuccessCallback& successCb,
+           const ndn::security::DataValidationFailureCallback& failureCb);
+
+  /*! \brief Drop all cached keys, e.g. after the trust schema is reloaded.
+   */
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  uint64_t
+  getHitCount() const
+  {
+    return m_nHits;
+  }
+
+  uint64_t
+  getMissCount() const
+  {
+    return m_nMisses;
+  }
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Find an unexpired certificate for \p keyLocatorName under \p context.
+   *
+   * \p keyLocatorName may be either a key name or a certificate name. In the
+   * latter case it must match the name of the cached certificate.
+   */
+  const ndn::security::Certificate*
+  find(const ndn::Name& context, const ndn::Name& keyLocatorName);
+
+  /*! \brief Cache the certificate the Validator trusted for \p keyLocatorName.
+   *
+   * The certificate is looked up in the Validator's trust anchors and verified
+   * certificate cache; nothing is cached if it is in neither.
+   */
+  void
+  insert(const ndn::Name& context, const ndn::Name& keyLocatorName);
+
+private:
+  void
+  onValidated(const ndn::Data& data, const ndn::Name& context,
+              const ndn::security::DataValidationSuccessCallback& successCb);
+
+public:
+  static const ndn::time::seconds DEFAULT_MAX_LIFETIME;
+
+private:
+  struct Entry
+  {
+    ndn::security::Certificate certificate;
+    /*! Full name of the certificate, including its implicit digest */
+    ndn::Name certificateDigest;
+    ndn::time::system_clock::TimePoint expirationTime;
+  };
+
+  using EntryKey = std::pair<ndn::Name, ndn::Name>;
+
+  ndn::security::Validator& m_validator;
+  ndn::time::seconds m_maxLifetime;
+  std::map<EntryKey, Entry> m_entries;
+
+  uint64_t m_nHits = 0;
+  uint64_t m_nMisses = 0;
+};
+
+} // namespace security
+} // namespace nlsr
+
+#endif // NLSR_VERIFIED_KEY_CACHE_HPP
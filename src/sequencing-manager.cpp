@@ -25,57 +25,112 @@
 #include <string>
 #include <fstream>
 #include <pwd.h>
+#include <cerrno>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace nlsr {
 
 INIT_LOGGER(SequencingManager);
 
-SequencingManager::SequencingManager(const std::string& filePath, int hypState,
-                                     int mState)
-  : m_hyperbolicState(hypState)
+const char SequencingManager::JOURNAL_MAGIC[8] = {'N', 'L', 'S', 'R', 'S', 'E', 'Q', 'J'};
+const uint32_t SequencingManager::JOURNAL_VERSION = 1;
+const ndn::time::seconds SequencingManager::SYNC_INTERVAL = ndn::time::seconds(1);
+const uint64_t SequencingManager::LEGACY_SEQ_INCREMENT = 10;
+
+SequencingManager::SequencingManager(ndn::Scheduler& scheduler, const std::string& filePath,
+                                     int hypState, int mState)
+  : m_scheduler(scheduler)
+  , m_hyperbolicState(hypState)
   , m_midstState(mState)
 {
   setSeqFileDirectory(filePath);
+  openJournal();
   initiateSeqNoFromFile();
 }
 
+SequencingManager::~SequencingManager()
+{
+  if (m_journal != nullptr) {
+    ::msync(m_journal, sizeof(Journal), MS_SYNC);
+    ::munmap(m_journal, sizeof(Journal));
+  }
+}
+
 void
-SequencingManager::writeSeqNoToFile() const
+SequencingManager::writeSeqNoToFile()
 {
   writeLog();
-  std::ofstream outputFile(m_seqFileNameWithPath.c_str());
-  std::ostringstream os;
-  os << "NameLsaSeq " << std::to_string(m_nameLsaSeq) << "\n"
-     << "AdjLsaSeq "  << std::to_string(m_adjLsaSeq)  << "\n"
-     << "CorLsaSeq "  << std::to_string(m_corLsaSeq)  << "\n"
-     << "MidstLsaSeq " << std::to_string(m_midstLsaSeq);
-  outputFile << os.str();
-  outputFile.close();
+  if (m_journal == nullptr) {
+    writeLegacyFile();
+    return;
+  }
+
+  // Overwrite the older record so that the newer one survives a torn write
+  uint64_t generation = m_generation + 1;
+  JournalRecord& record = m_journal->records[generation % 2];
+  record.generation = generation;
+  record.nameLsaSeq = m_nameLsaSeq;
+  record.adjLsaSeq = m_adjLsaSeq;
+  record.corLsaSeq = m_corLsaSeq;
+  record.midstLsaSeq = m_midstLsaSeq;
+  record.checksum = computeChecksum(record);
+  m_generation = generation;
+
+  auto now = ndn::time::steady_clock::now();
+  if (now - m_lastSyncTime >= SYNC_INTERVAL) {
+    syncJournal();
+    return;
+  }
+
+  if (::msync(m_journal, sizeof(Journal), MS_ASYNC) != 0) {
+    NLSR_LOG_WARN("Failed to flush " << m_journalFileNameWithPath << ": " << std::strerror(errno));
+  }
+  // The last write of a burst must reach the disk even if no other write follows
+  if (!m_isSyncScheduled) {
+    m_isSyncScheduled = true;
+    m_syncEvent = m_scheduler.schedule(m_lastSyncTime + SYNC_INTERVAL - now,
+                                       [this] { syncJournal(); });
+  }
+}
+
+void
+SequencingManager::syncJournal()
+{
+  m_syncEvent.cancel();
+  m_isSyncScheduled = false;
+  m_lastSyncTime = ndn::time::steady_clock::now();
+  if (::msync(m_journal, sizeof(Journal), MS_SYNC) != 0) {
+    NLSR_LOG_WARN("Failed to flush " << m_journalFileNameWithPath << ": " << std::strerror(errno));
+  }
 }
 
 void
 SequencingManager::initiateSeqNoFromFile()
 {
-  NLSR_LOG_DEBUG("Seq File Name: " << m_seqFileNameWithPath);
-  std::ifstream inputFile(m_seqFileNameWithPath.c_str());
+  NLSR_LOG_DEBUG("Seq File Name: " << m_journalFileNameWithPath);
 
-  std::string seqType;
-  // Good checks that file is not (bad or eof or fail)
-  if (inputFile.good()) {
-    inputFile >> seqType >> m_nameLsaSeq;
-    inputFile >> seqType >> m_adjLsaSeq;
-    inputFile >> seqType >> m_corLsaSeq;
-    inputFile >> seqType >> m_midstLsaSeq;
+  bool isLegacy = false;
+  bool isFound = readJournal();
+  if (!isFound) {
+    isFound = isLegacy = readLegacyFile();
+  }
 
-    inputFile.close();
+  if (isFound) {
+    // The journal always holds the last sequence numbers that were used. The
+    // text file could be behind if the last run of NLSR crashed before writing
+    // it, so skip ahead by a few numbers when reading it, whether migrating
+    // or falling back to it because the journal cannot be used.
+    uint64_t increment = isLegacy ? LEGACY_SEQ_INCREMENT : 0;
 
-    // Increment by 10 in case last run of NLSR was not able to write to file
-    // before crashing
     // Increment the Name LSA seq. no. if MIDST is NOT enabled
     if (m_midstState == MIDST_STATE_OFF) {
-      m_nameLsaSeq += 10;
+      m_nameLsaSeq += increment;
     }
 
     // Send a warning message if hyperbolic routing and MIDST are enabled
@@ -97,7 +152,7 @@ SequencingManager::initiateSeqNoFromFile()
                   << " without clearing the seq. no. file.");
         m_midstLsaSeq = 0;
       }
-      m_adjLsaSeq += 10;
+      m_adjLsaSeq += increment;
     }
 
     // Similarly, increment the coordinate LSA seq. no only if link-state is disabled.
@@ -112,7 +167,7 @@ SequencingManager::initiateSeqNoFromFile()
                   << " without clearing the seq. no. file.");
         m_midstLsaSeq = 0;
       }
-      m_corLsaSeq += 10;
+      m_corLsaSeq += increment;
     }
 
     // Increment the MIDST LSA seq. no. if MIDST is enabled
@@ -127,10 +182,130 @@ SequencingManager::initiateSeqNoFromFile()
                    << " routing without clearing the name seq. no. file.");
         m_nameLsaSeq = 0;
       }
-      m_midstLsaSeq += 10;
+      m_midstLsaSeq += increment;
     }
   }
   writeLog();
+
+  if (isLegacy && m_journal != nullptr) {
+    NLSR_LOG_INFO("Migrating " << m_seqFileNameWithPath << " to " << m_journalFileNameWithPath);
+    writeSeqNoToFile();
+    std::remove(m_seqFileNameWithPath.c_str());
+  }
+}
+
+bool
+SequencingManager::readJournal()
+{
+  if (m_journal == nullptr) {
+    return false;
+  }
+
+  const JournalRecord* latest = nullptr;
+  for (const auto& record : m_journal->records) {
+    if (record.checksum == computeChecksum(record) &&
+        (latest == nullptr || record.generation > latest->generation)) {
+      latest = &record;
+    }
+  }
+  if (latest == nullptr) {
+    return false;
+  }
+
+  m_generation = latest->generation;
+  m_nameLsaSeq = latest->nameLsaSeq;
+  m_adjLsaSeq = latest->adjLsaSeq;
+  m_corLsaSeq = latest->corLsaSeq;
+  m_midstLsaSeq = latest->midstLsaSeq;
+  return true;
+}
+
+void
+SequencingManager::writeLegacyFile() const
+{
+  std::ofstream outputFile(m_seqFileNameWithPath.c_str());
+  outputFile << "NameLsaSeq " << m_nameLsaSeq << "\n"
+             << "AdjLsaSeq "  << m_adjLsaSeq  << "\n"
+             << "CorLsaSeq "  << m_corLsaSeq  << "\n"
+             << "MidstLsaSeq " << m_midstLsaSeq;
+  outputFile.close();
+  if (!outputFile) {
+    NLSR_LOG_ERROR("Cannot write " << m_seqFileNameWithPath);
+  }
+}
+
+bool
+SequencingManager::readLegacyFile()
+{
+  std::ifstream inputFile(m_seqFileNameWithPath.c_str());
+
+  std::string seqType;
+  // Good checks that file is not (bad or eof or fail)
+  if (!inputFile.good()) {
+    return false;
+  }
+
+  inputFile >> seqType >> m_nameLsaSeq;
+  inputFile >> seqType >> m_adjLsaSeq;
+  inputFile >> seqType >> m_corLsaSeq;
+  inputFile >> seqType >> m_midstLsaSeq;
+  return true;
+}
+
+void
+SequencingManager::openJournal()
+{
+  int fd = ::open(m_journalFileNameWithPath.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    NLSR_LOG_ERROR("Cannot open " << m_journalFileNameWithPath << ": " << std::strerror(errno) <<
+                   ", saving sequence numbers to " << m_seqFileNameWithPath);
+    return;
+  }
+
+  struct stat st;
+  bool isNew = ::fstat(fd, &st) != 0 || st.st_size != static_cast<off_t>(sizeof(Journal));
+  if (isNew && ::ftruncate(fd, sizeof(Journal)) != 0) {
+    NLSR_LOG_ERROR("Cannot resize " << m_journalFileNameWithPath << ": " << std::strerror(errno) <<
+                   ", saving sequence numbers to " << m_seqFileNameWithPath);
+    ::close(fd);
+    return;
+  }
+
+  void* addr = ::mmap(nullptr, sizeof(Journal), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    NLSR_LOG_ERROR("Cannot map " << m_journalFileNameWithPath << ": " << std::strerror(errno) <<
+                   ", saving sequence numbers to " << m_seqFileNameWithPath);
+    return;
+  }
+  m_journal = static_cast<Journal*>(addr);
+
+  if (isNew || std::memcmp(m_journal->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+      m_journal->version != JOURNAL_VERSION) {
+    if (!isNew) {
+      NLSR_LOG_WARN(m_journalFileNameWithPath << " has an unknown format, resetting it");
+    }
+    std::memset(m_journal, 0, sizeof(Journal));
+    std::memcpy(m_journal->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    m_journal->version = JOURNAL_VERSION;
+    ::msync(m_journal, sizeof(Journal), MS_SYNC);
+  }
+}
+
+uint64_t
+SequencingManager::computeChecksum(const JournalRecord& record)
+{
+  // 64-bit FNV-1a, so an unwritten (all zero) record does not pass the check
+  uint64_t hash = 0xcbf29ce484222325;
+  for (uint64_t value : {record.generation, record.nameLsaSeq, record.adjLsaSeq,
+                         record.corLsaSeq, record.midstLsaSeq}) {
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (i * 8)) & 0xff;
+      hash *= 0x100000001b3;
+    }
+  }
+  return hash;
 }
 
 void
@@ -145,6 +320,7 @@ SequencingManager::setSeqFileDirectory(const std::string& filePath)
     }
     m_seqFileNameWithPath = homeDirPath;
   }
+  m_journalFileNameWithPath = m_seqFileNameWithPath + "/nlsrSeqNo.journal";
   m_seqFileNameWithPath = m_seqFileNameWithPath + "/nlsrSeqNo.txt";
 }
 
@@ -27,16 +27,41 @@
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/face.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <boost/noncopyable.hpp>
 
 #include <list>
 #include <string>
 
 namespace nlsr {
 
-class SequencingManager
+/*! \brief Keeps track of this router's LSA sequence numbers across restarts.
+ *
+ * The sequence numbers are saved in a small binary journal (nlsrSeqNo.journal)
+ * that is memory-mapped for the lifetime of the manager. The journal holds two
+ * records, each with a generation number and a checksum, and every write
+ * overwrites the older one. A torn write therefore leaves the previous record
+ * intact, and the sequence numbers are recovered exactly on restart.
+ *
+ * Writes go to the page cache right away, so they survive a crash of NLSR
+ * itself. They are flushed to disk asynchronously, and synchronously at most
+ * once per SYNC_INTERVAL: a write that comes sooner schedules the synchronous
+ * flush for the end of the interval, so no write stays unflushed for longer
+ * than SYNC_INTERVAL. The journal is also flushed when the manager is destroyed.
+ *
+ * A text nlsrSeqNo.txt left by an older version is migrated to the journal.
+ * If the journal cannot be opened or mapped, the sequence numbers are saved to
+ * that text file instead, as older versions did, and skipped ahead on restart.
+ */
+class SequencingManager : boost::noncopyable
 {
 public:
-  SequencingManager(const std::string& filePath, int hypState, int mState);
+  SequencingManager(ndn::Scheduler& scheduler, const std::string& filePath, int hypState,
+                    int mState);
+
+  ~SequencingManager();
 
   void
   setLsaSeq(uint64_t seqNo, Lsa::Type lsaType)
@@ -148,13 +173,48 @@ public:
     m_midstLsaSeq++;
   }
 
+  /*! \brief Save the current sequence numbers to the journal. */
   void
-  writeSeqNoToFile() const;
+  writeSeqNoToFile();
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   initiateSeqNoFromFile();
 
+  struct JournalRecord
+  {
+    uint64_t generation;
+    uint64_t nameLsaSeq;
+    uint64_t adjLsaSeq;
+    uint64_t corLsaSeq;
+    uint64_t midstLsaSeq;
+    uint64_t checksum;
+  };
+
+  struct Journal
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    // the record of generation g is kept in records[g % 2]
+    JournalRecord records[2];
+  };
+
+  static uint64_t
+  computeChecksum(const JournalRecord& record);
+
+  const std::string&
+  getJournalFilePath() const
+  {
+    return m_journalFileNameWithPath;
+  }
+
+  const std::string&
+  getLegacyFilePath() const
+  {
+    return m_seqFileNameWithPath;
+  }
+
 private:
   /*! \brief Set the sequence file directory
 
@@ -165,6 +225,36 @@ private:
   void
   setSeqFileDirectory(const std::string& filePath);
 
+  /*! \brief Create the journal file if needed and map it into memory.
+   *
+   * On failure, an error is logged and the sequence numbers are saved to the
+   * text file instead.
+   */
+  void
+  openJournal();
+
+  /*! \brief Load the sequence numbers from the newest valid journal record.
+   *
+   * \return false if the journal has no valid record
+   */
+  bool
+  readJournal();
+
+  /*! \brief Load the sequence numbers from a text file written by older versions.
+   *
+   * \return false if there is no such file
+   */
+  bool
+  readLegacyFile();
+
+  /*! \brief Save the sequence numbers to the text file, when there is no journal. */
+  void
+  writeLegacyFile() const;
+
+  /*! \brief Flush the journal to disk and wait for it. */
+  void
+  syncJournal();
+
   void
   writeLog() const;
 
@@ -174,6 +264,22 @@ private:
   uint64_t m_corLsaSeq = 0;
   uint64_t m_midstLsaSeq = 0;
   std::string m_seqFileNameWithPath;
+  std::string m_journalFileNameWithPath;
+
+  ndn::Scheduler& m_scheduler;
+  Journal* m_journal = nullptr;
+  uint64_t m_generation = 0;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  ndn::time::steady_clock::TimePoint m_lastSyncTime;
+  ndn::scheduler::ScopedEventId m_syncEvent;
+  bool m_isSyncScheduled = false;
+
+private:
+  static const char JOURNAL_MAGIC[8];
+  static const uint32_t JOURNAL_VERSION;
+  static const ndn::time::seconds SYNC_INTERVAL;
+  static const uint64_t LEGACY_SEQ_INCREMENT;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   int m_hyperbolicState;
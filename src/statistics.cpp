@@ -43,6 +43,12 @@ Statistics::increment(PacketType type)
   m_packetCounter[type]++;
 }
 
+void
+Statistics::set(PacketType type, int value)
+{
+  m_packetCounter[type] = value;
+}
+
 void
 Statistics::resetAll()
 {
@@ -94,6 +100,19 @@ operator<<(std::ostream& os, const Statistics& stats)
      << "    Received Coordinate LSA Data: "      << stats.get(PacketType::RCV_COORD_LSA_DATA) << "\n"
      << "    Received Name LSA Data: "            << stats.get(PacketType::RCV_NAME_LSA_DATA) << "\n"
      << "    Received MIDST DV Data: "            << stats.get(PacketType::RCV_MIDST_DV_DATA) << "\n"
+     << "    Merged MIDST DV Updates: "           << stats.get(PacketType::MERGED_MIDST_DV_UPDATE) << "\n"
+     << "\n"
+     << "    Adjacency LSA Build Requests: "      << stats.get(PacketType::ADJ_LSA_BUILD_REQUEST) << "\n"
+     << "    Adjacency LSA Builds: "              << stats.get(PacketType::ADJ_LSA_BUILD) << "\n"
+     << "    Throttled Adjacency LSA Builds: "    << stats.get(PacketType::ADJ_LSA_BUILD_BACKOFF) << "\n"
+     << "    Adjacency LSA Build Hold Time (ms): " << stats.get(PacketType::ADJ_LSA_BUILD_HOLD_TIME) << "\n"
+     << "\n"
+     << "    Routing Calculation Requests: "      << stats.get(PacketType::ROUTING_CALC_REQUEST) << "\n"
+     << "    Routing Calculations: "              << stats.get(PacketType::ROUTING_CALC) << "\n"
+     << "    Throttled Routing Calculations: "    << stats.get(PacketType::ROUTING_CALC_BACKOFF) << "\n"
+     << "\n"
+     << "    Received Sync Updates: "             << stats.get(PacketType::RCV_SYNC_UPDATE) << "\n"
+     << "    Coalesced Sync Updates: "            << stats.get(PacketType::SYNC_UPDATE_COALESCED) << "\n"
      << "++++++++++++++++++++++++++++++++++++++++\n";
 
   return os;
@@ -54,7 +54,17 @@ public:
     RCV_ADJ_LSA_DATA,
     RCV_COORD_LSA_DATA,
     RCV_NAME_LSA_DATA,
-    RCV_MIDST_DV_DATA       // New
+    RCV_MIDST_DV_DATA,      // New
+    MERGED_MIDST_DV_UPDATE,
+    ADJ_LSA_BUILD_REQUEST,
+    ADJ_LSA_BUILD,
+    ADJ_LSA_BUILD_BACKOFF,
+    ADJ_LSA_BUILD_HOLD_TIME,
+    ROUTING_CALC_REQUEST,
+    ROUTING_CALC,
+    ROUTING_CALC_BACKOFF,
+    RCV_SYNC_UPDATE,
+    SYNC_UPDATE_COALESCED
   };
 
   size_t
@@ -63,6 +73,11 @@ public:
   void
   increment(PacketType);
 
+  /*! \brief Sets a value that is a current state rather than a count, like a hold time.
+   */
+  void
+  set(PacketType, int value);
+
   void
   resetAll();
 
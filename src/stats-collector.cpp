@@ -24,23 +24,40 @@
 
 namespace nlsr {
 
-StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp)
+StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp, RoutingTable& rt)
   : m_lsdb(lsdb)
   , m_hp(hp)
+  , m_rt(rt)
 {
   m_lsaIncrementConn =
   this->m_lsdb.lsaIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
                                                     this, _1));
 
+  m_adjLsaBuildHoldTimeConn =
+  this->m_lsdb.adjLsaBuildHoldTimeSignal.connect([this] (ndn::time::milliseconds holdTime) {
+    m_stats.set(Statistics::PacketType::ADJ_LSA_BUILD_HOLD_TIME, holdTime.count());
+  });
+
   m_helloIncrementConn =
   this->m_hp.hpIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
                                                  this, _1));
+
+  m_rtIncrementConn =
+  this->m_rt.rtIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
+                                                 this, _1));
+
+  m_syncIncrementConn =
+  this->m_lsdb.getSync().getSyncProtocolAdapter().syncIncrementSignal.connect(
+    std::bind(&StatsCollector::statsIncrement, this, _1));
 }
 
 StatsCollector::~StatsCollector()
 {
   m_lsaIncrementConn.disconnect();
+  m_adjLsaBuildHoldTimeConn.disconnect();
   m_helloIncrementConn.disconnect();
+  m_rtIncrementConn.disconnect();
+  m_syncIncrementConn.disconnect();
 }
 
 void
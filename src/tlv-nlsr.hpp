@@ -52,7 +52,10 @@ enum {
   MidstLsa                    = 146,
   MidstPrefixList             = 147,
   Distance                    = 148,
-  SeqNo                       = 149
+  SeqNo                       = 149,
+  DvDelta                     = 150,
+  NeighborStatus              = 151,
+  HelloInterval               = 152
 };
 
 } // namespace nlsr
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "exponential-throttle.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+namespace util {
+
+ExponentialThrottle::ExponentialThrottle(ndn::time::milliseconds initialDelay,
+                                         ndn::time::milliseconds holdTime,
+                                         ndn::time::milliseconds maxHoldTime)
+  : m_initialDelay(initialDelay)
+  , m_holdTime(std::max(holdTime, ndn::time::milliseconds(1)))
+  , m_maxHoldTime(std::max(maxHoldTime, m_holdTime))
+  , m_currentHoldTime(ndn::time::milliseconds::zero())
+  , m_nBackoffs(0)
+{
+}
+
+ndn::time::milliseconds
+ExponentialThrottle::next()
+{
+  auto now = ndn::time::steady_clock::now();
+  decay(now);
+
+  ndn::time::milliseconds delay = m_initialDelay;
+  if (m_currentHoldTime == ndn::time::milliseconds::zero()) {
+    m_currentHoldTime = m_holdTime;
+  }
+  else {
+    auto earliest = m_lastRun + m_currentHoldTime;
+    if (earliest - now > m_initialDelay) {
+      delay = ndn::time::duration_cast<ndn::time::milliseconds>(earliest - now);
+      ++m_nBackoffs;
+    }
+    m_currentHoldTime = std::min(2 * m_currentHoldTime, m_maxHoldTime);
+  }
+
+  m_lastRun = now + delay;
+  return delay;
+}
+
+void
+ExponentialThrottle::decay(const ndn::time::steady_clock::TimePoint& now)
+{
+  if (m_currentHoldTime == ndn::time::milliseconds::zero() || now < m_lastRun) {
+    return;
+  }
+
+  auto quiet = now - m_lastRun;
+  while (m_currentHoldTime > ndn::time::milliseconds::zero() && quiet >= m_currentHoldTime) {
+    quiet -= m_currentHoldTime;
+    m_currentHoldTime = m_currentHoldTime > m_holdTime ?
+                        std::max(m_currentHoldTime / 2, m_holdTime) :
+                        ndn::time::milliseconds::zero();
+  }
+}
+
+} // namespace util
+} // namespace nlsr
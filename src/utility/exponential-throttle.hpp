@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_UTILITY_EXPONENTIAL_THROTTLE_HPP
+#define NLSR_UTILITY_EXPONENTIAL_THROTTLE_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/util/time.hpp>
+
+namespace nlsr {
+namespace util {
+
+/*! \brief Spaces out repeated runs of an action with exponentially growing hold times.
+ *
+ * Modeled after OSPF LSA and SPF throttling. The first request after a quiet
+ * period runs after the initial delay. While requests keep coming, each run
+ * waits at least the hold time after the previous one, and the hold time
+ * doubles with every run, up to the maximum. Each hold time that passes
+ * without a request halves it again; once it is back at its starting value,
+ * the throttle is idle and the next request gets the initial delay.
+ *
+ * The throttle does not schedule anything itself. The caller asks next() for
+ * the delay of a run, schedules it, and merges requests that arrive while a
+ * run is already pending.
+ */
+class ExponentialThrottle
+{
+public:
+  ExponentialThrottle(ndn::time::milliseconds initialDelay,
+                      ndn::time::milliseconds holdTime,
+                      ndn::time::milliseconds maxHoldTime);
+
+  /*! \brief Returns how long to wait before the next run of the action.
+   *
+   * Must be called once for every run that the caller schedules.
+   */
+  ndn::time::milliseconds
+  next();
+
+  ndn::time::milliseconds
+  getInitialDelay() const
+  {
+    return m_initialDelay;
+  }
+
+  /*! \brief Returns the hold time applied to the next run, zero if idle.
+   */
+  ndn::time::milliseconds
+  getCurrentHoldTime() const
+  {
+    return m_currentHoldTime;
+  }
+
+  ndn::time::milliseconds
+  getMaxHoldTime() const
+  {
+    return m_maxHoldTime;
+  }
+
+  /*! \brief Returns how many runs were delayed beyond the initial delay.
+   */
+  uint64_t
+  getNBackoffs() const
+  {
+    return m_nBackoffs;
+  }
+
+private:
+  void
+  decay(const ndn::time::steady_clock::TimePoint& now);
+
+private:
+  ndn::time::milliseconds m_initialDelay;
+  ndn::time::milliseconds m_holdTime;
+  ndn::time::milliseconds m_maxHoldTime;
+
+  ndn::time::milliseconds m_currentHoldTime;
+  ndn::time::steady_clock::TimePoint m_lastRun;
+  uint64_t m_nBackoffs;
+};
+
+} // namespace util
+} // namespace nlsr
+
+#endif // NLSR_UTILITY_EXPONENTIAL_THROTTLE_HPP
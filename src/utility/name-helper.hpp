@@ -36,9 +36,8 @@ namespace util {
    starting from 0
  */
 inline int32_t
-getNameComponentPosition(const ndn::Name& name, const std::string& searchString)
+getNameComponentPosition(const ndn::Name& name, const ndn::name::Component& component)
 {
-  ndn::name::Component component(searchString);
   size_t nameSize = name.size();
   for (uint32_t i = 0; i < nameSize; i++) {
     if (component == name[i]) {
@@ -48,6 +47,81 @@ getNameComponentPosition(const ndn::Name& name, const std::string& searchString)
   return -1;
 }
 
+inline int32_t
+getNameComponentPosition(const ndn::Name& name, const std::string& searchString)
+{
+  return getNameComponentPosition(name, ndn::name::Component(searchString));
+}
+
+/*! \brief Precomputed layout of LSA names.
+ *
+ * LSA names are /<lsa-prefix>/<router>/<type>, followed by trailing components
+ * such as the sequence number, where <router> is the origin router name without
+ * the network prefix. The layout is computed once from the configuration, so
+ * checking a name only compares its components in place, without converting
+ * them to strings or copying the name.
+ */
+class LsaNameLayout
+{
+public:
+  LsaNameLayout(const ndn::Name& lsaPrefix, const ndn::Name& network)
+    : m_lsaPrefix(lsaPrefix)
+    , m_network(network)
+  {
+  }
+
+  /*! \brief Whether \p name is an LSA name with \p nTrailing components after the type
+   */
+  bool
+  matches(const ndn::Name& name, size_t nTrailing) const
+  {
+    return name.size() >= m_lsaPrefix.size() + 2 + nTrailing && m_lsaPrefix.isPrefixOf(name);
+  }
+
+  /*! \brief The component holding the LSA type
+   *  \pre matches(name, nTrailing)
+   */
+  const ndn::name::Component&
+  getTypeComponent(const ndn::Name& name, size_t nTrailing) const
+  {
+    return name[name.size() - nTrailing - 1];
+  }
+
+  /*! \brief Whether \p name was originated by \p router
+   *  \pre matches(name, nTrailing)
+   */
+  bool
+  isFromRouter(const ndn::Name& name, size_t nTrailing, const ndn::Name& router) const
+  {
+    size_t routerSize = name.size() - m_lsaPrefix.size() - nTrailing - 1;
+    if (router.size() != m_network.size() + routerSize || !m_network.isPrefixOf(router)) {
+      return false;
+    }
+    for (size_t i = 0; i < routerSize; i++) {
+      if (name[m_lsaPrefix.size() + i] != router[m_network.size() + i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /*! \brief Build the name of the router that originated \p name
+   *  \pre matches(name, nTrailing)
+   */
+  ndn::Name
+  getOriginRouter(const ndn::Name& name, size_t nTrailing) const
+  {
+    ndn::Name originRouter(m_network);
+    originRouter.append(name.getSubName(m_lsaPrefix.size(),
+                                        name.size() - m_lsaPrefix.size() - nTrailing - 1));
+    return originRouter;
+  }
+
+private:
+  ndn::Name m_lsaPrefix;
+  ndn::Name m_network;
+};
+
 } // namespace util
 } // namespace nlsr
 
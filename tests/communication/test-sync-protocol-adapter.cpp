@@ -105,6 +105,35 @@ BOOST_FIXTURE_TEST_CASE(Basic, SyncProtocolAdapterFixture)
   BOOST_CHECK_EQUAL(it->second, 10);
 }
 
+BOOST_FIXTURE_TEST_CASE(IbfSize, SyncProtocolAdapterFixture)
+{
+  ndn::util::DummyClientFace face(m_ioService, util::DummyClientFace::Options{true, true});
+  SyncProtocolAdapter node(face, SYNC_PROTOCOL_PSYNC, syncPrefix, nameLsaUserPrefix,
+                           syncInterestLifetime,
+                           [] (const ndn::Name& updateName, uint64_t highSeq) {},
+                           10);
+  std::map<Statistics::PacketType, int> counts;
+  node.syncIncrementSignal.connect([&] (Statistics::PacketType type) { ++counts[type]; });
+  advanceClocks(ndn::time::milliseconds(10), 10);
+
+  std::vector<psync::MissingDataInfo> updates;
+  for (int i = 0; i < 12; ++i) {
+    updates.push_back({Name(nameLsaUserPrefix).appendNumber(i), 1, 1});
+  }
+  node.onPSyncUpdate(updates);
+  BOOST_CHECK_EQUAL(counts[Statistics::PacketType::RCV_SYNC_UPDATE], 12);
+
+  // The IBF keeps the configured size, which all routers share
+  advanceClocks(ndn::time::milliseconds(10), 10);
+  BOOST_CHECK_EQUAL(node.getIbfSize(), 10);
+  BOOST_CHECK(node.m_hasWarnedIbfSize);
+
+  // Updates that cover several sequence numbers are counted
+  node.onPSyncUpdate({{Name(nameLsaUserPrefix).appendNumber(0), 2, 4}});
+  node.onPSyncUpdate({{Name(nameLsaUserPrefix).appendNumber(0), 5, 5}});
+  BOOST_CHECK_EQUAL(counts[Statistics::PacketType::SYNC_UPDATE_COALESCED], 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
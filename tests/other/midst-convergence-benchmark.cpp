@@ -0,0 +1,724 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ * \brief MIDST convergence benchmark.
+ *
+ * Runs several Nlsr instances in one process, each on its own DummyClientFace,
+ * under virtual time. A small forwarder moves packets between the faces of
+ * linked routers and answers the faces dataset query of every router.
+ * The benchmark waits for the initial convergence, then fails and restores
+ * the requested links one after another, and reports for each phase the
+ * convergence time and the DV and hello traffic, and for each router the
+ * packets and bytes it sent and the CPU time spent processing its packets.
+ *
+ * A phase has converged when every router has a route to exactly the routers
+ * it can reach and its routing table has not changed for the settle time.
+ */
+
+#include "nlsr.hpp"
+#include "conf-parameter.hpp"
+#include "route/routing-table.hpp"
+
+#include <ndn-cxx/mgmt/nfd/face-status.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+#include <ndn-cxx/util/time-unit-test-clock.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <map>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <time.h>
+
+namespace nlsr {
+namespace tests {
+
+namespace time = ndn::time;
+
+struct Link
+{
+  size_t a;
+  size_t b;
+  double cost;
+  bool isUp;
+};
+
+/*! \brief Traffic counters, kept per router and per phase.
+ */
+struct Counters
+{
+  uint64_t nDvInterests = 0;
+  uint64_t nDvData = 0;
+  uint64_t nDvBytes = 0;
+  uint64_t nHelloInterests = 0;
+  uint64_t nHelloData = 0;
+  uint64_t nOtherPackets = 0;
+  uint64_t nBytes = 0;
+  time::nanoseconds cpuTime = time::nanoseconds::zero();
+
+  Counters&
+  operator+=(const Counters& other)
+  {
+    nDvInterests += other.nDvInterests;
+    nDvData += other.nDvData;
+    nDvBytes += other.nDvBytes;
+    nHelloInterests += other.nHelloInterests;
+    nHelloData += other.nHelloData;
+    nOtherPackets += other.nOtherPackets;
+    nBytes += other.nBytes;
+    cpuTime += other.cpuTime;
+    return *this;
+  }
+};
+
+static time::nanoseconds
+getThreadCpuTime()
+{
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return time::seconds(ts.tv_sec) + time::nanoseconds(ts.tv_nsec);
+}
+
+static bool
+hasComponents(const ndn::Name& name, const char* first, const char* second)
+{
+  for (size_t i = 0; i + 1 < name.size(); ++i) {
+    if (name[i] == ndn::name::Component(first) && name[i + 1] == ndn::name::Component(second)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+class Router
+{
+public:
+  Router(boost::asio::io_service& ioService, ndn::KeyChain& keyChain, size_t index,
+         const boost::filesystem::path& stateDir)
+    : index(index)
+    , face(ioService, keyChain, {false, true})
+    , conf(face, keyChain)
+  {
+    conf.setNetwork("/ndn");
+    conf.setSiteName("/site");
+    conf.setRouterName("/%C1.Router/router" + std::to_string(index));
+    conf.buildRouterAndSyncUserPrefix();
+    conf.setStateFileDir(stateDir.string());
+    conf.setMidstState(MIDST_STATE_ON);
+  }
+
+  const ndn::Name&
+  getName() const
+  {
+    return conf.getRouterPrefix();
+  }
+
+  /*! \brief The FaceUri this router uses to reach \p neighbor.
+   */
+  static ndn::FaceUri
+  makeFaceUri(size_t neighbor)
+  {
+    return ndn::FaceUri("udp4://10." + std::to_string(neighbor / 256) + "." +
+                        std::to_string(neighbor % 256) + ".1:6363");
+  }
+
+public:
+  const size_t index;
+  ndn::util::DummyClientFace face;
+  ConfParameter conf;
+  std::unique_ptr<Nlsr> nlsr;
+
+  // neighbor index => FaceId of the face toward it
+  std::map<size_t, uint64_t> faceIds;
+  time::steady_clock::TimePoint lastRouteChange;
+  Counters counters;
+};
+
+class ConvergenceBenchmark
+{
+public:
+  struct Options
+  {
+    time::milliseconds linkDelay{10};
+    time::milliseconds tick{10};
+    time::seconds settleTime{10};
+    time::seconds timeout{600};
+    uint32_t helloInterval = 30;
+    uint32_t helloTimeout = 1;
+    uint32_t helloRetries = 3;
+    uint32_t routingCalcInterval = 1;
+  };
+
+  ConvergenceBenchmark(size_t nRouters, std::vector<Link> links, const Options& options)
+    : m_steadyClock(std::make_shared<time::UnitTestSteadyClock>())
+    , m_systemClock(std::make_shared<time::UnitTestSystemClock>())
+    , m_keyChain("pib-memory:", "tpm-memory:")
+    , m_scheduler(m_ioService)
+    , m_links(std::move(links))
+    , m_options(options)
+    , m_stateDir(boost::filesystem::temp_directory_path() /
+                 boost::filesystem::unique_path("nlsr-benchmark-%%%%%%%%"))
+  {
+    time::setCustomClocks(m_steadyClock, m_systemClock);
+
+    for (size_t i = 0; i < nRouters; ++i) {
+      auto stateDir = m_stateDir / std::to_string(i);
+      boost::filesystem::create_directories(stateDir);
+      m_routers.push_back(std::make_unique<Router>(m_ioService, m_keyChain, i, stateDir));
+      m_pit.emplace_back();
+    }
+
+    for (const auto& link : m_links) {
+      addAdjacency(*m_routers[link.a], link.b, link.cost);
+      addAdjacency(*m_routers[link.b], link.a, link.cost);
+    }
+
+    for (auto& router : m_routers) {
+      configure(*router);
+    }
+  }
+
+  ~ConvergenceBenchmark()
+  {
+    m_routers.clear();
+    time::setCustomClocks(nullptr, nullptr);
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(m_stateDir, ec);
+  }
+
+  /*! \brief Runs until the network converges or the timeout passes.
+   *  \return the time from now to the last routing change, if converged
+   */
+  ndn::optional<time::nanoseconds>
+  runUntilConverged()
+  {
+    auto start = time::steady_clock::now();
+    for (auto& router : m_routers) {
+      router->lastRouteChange = start;
+    }
+
+    while (time::steady_clock::now() - start < m_options.timeout) {
+      advanceClocks(m_options.tick);
+
+      auto lastChange = start;
+      for (const auto& router : m_routers) {
+        lastChange = std::max(lastChange, router->lastRouteChange);
+      }
+      if (time::steady_clock::now() - lastChange >= m_options.settleTime && hasExpectedRoutes()) {
+        return lastChange - start;
+      }
+    }
+    return ndn::nullopt;
+  }
+
+  void
+  setLinkState(size_t linkIndex, bool isUp)
+  {
+    m_links.at(linkIndex).isUp = isUp;
+  }
+
+  /*! \brief Returns the counters of every router and resets them.
+   */
+  std::vector<Counters>
+  takeCounters()
+  {
+    std::vector<Counters> counters;
+    for (auto& router : m_routers) {
+      counters.push_back(router->counters);
+      router->counters = Counters();
+    }
+    return counters;
+  }
+
+  const Router&
+  getRouter(size_t index) const
+  {
+    return *m_routers.at(index);
+  }
+
+  const Link&
+  getLink(size_t index) const
+  {
+    return m_links.at(index);
+  }
+
+private:
+  void
+  addAdjacency(Router& router, size_t neighbor, double cost)
+  {
+    uint64_t faceId = 256 + router.faceIds.size();
+    router.faceIds[neighbor] = faceId;
+    router.conf.getAdjacencyList().insert(Adjacent(m_routers[neighbor]->getName(),
+                                                   Router::makeFaceUri(neighbor), cost,
+                                                   Adjacent::STATUS_INACTIVE, 0, 0));
+  }
+
+  void
+  configure(Router& router)
+  {
+    ConfParameter& conf = router.conf;
+    conf.setInfoInterestInterval(m_options.helloInterval);
+    conf.setInterestResendTime(m_options.helloTimeout);
+    conf.setInterestRetryNumber(m_options.helloRetries);
+    conf.setRoutingCalcInterval(m_options.routingCalcInterval);
+
+    ndn::Name prefix(router.getName());
+    prefix.append("prefix");
+    conf.getMidstPrefixList().insert(prefix, 0, router.getName(), 1);
+
+    // Every router trusts every other one; signing is still done for real so
+    // that its cost shows up in the CPU time
+    conf.getValidator().load("trust-anchor\n{\n  type any\n}\n", "midst-benchmark");
+    m_keyChain.createIdentity(router.getName());
+    conf.initializeKey();
+
+    router.face.onSendInterest.connect([this, &router] (const ndn::Interest& interest) {
+      onSendInterest(router, interest);
+    });
+    router.face.onSendData.connect([this, &router] (const ndn::Data& data) {
+      onSendData(router, data);
+    });
+
+    router.nlsr = std::make_unique<Nlsr>(router.face, m_keyChain, conf);
+    router.nlsr->m_routingTable.afterRoutingChange.connect(
+      [&router] (const std::list<RoutingTableEntry>&) {
+        router.lastRouteChange = time::steady_clock::now();
+      });
+  }
+
+  void
+  count(Router& router, const ndn::Name& name, size_t size, bool isInterest)
+  {
+    Counters& counters = router.counters;
+    counters.nBytes += size;
+    if (hasComponents(name, "nlsr", "DV")) {
+      ++(isInterest ? counters.nDvInterests : counters.nDvData);
+      counters.nDvBytes += size;
+    }
+    else if (hasComponents(name, "nlsr", "INFO")) {
+      ++(isInterest ? counters.nHelloInterests : counters.nHelloData);
+    }
+    else {
+      ++counters.nOtherPackets;
+    }
+  }
+
+  void
+  onSendInterest(Router& router, const ndn::Interest& interest)
+  {
+    static const ndn::Name FACES_LIST("/localhost/nfd/faces/list");
+    const ndn::Name& name = interest.getName();
+
+    if (FACES_LIST.isPrefixOf(name)) {
+      m_scheduler.schedule(time::milliseconds(1), [this, &router, interest] {
+        answerFaceDataset(router, interest);
+      });
+      return;
+    }
+    if (name.size() > 0 && name[0] == ndn::name::Component("localhost")) {
+      return;
+    }
+
+    count(router, name, interest.wireEncode().size(), true);
+
+    // Router-specific Interests go to that neighbor only, the rest (sync) to all
+    for (const auto& link : m_links) {
+      if (!link.isUp || (link.a != router.index && link.b != router.index)) {
+        continue;
+      }
+      Router& neighbor = *m_routers[link.a == router.index ? link.b : link.a];
+      if (neighbor.getName().isPrefixOf(name) || !isRouterSpecific(name)) {
+        forwardInterest(router, neighbor, interest);
+      }
+    }
+  }
+
+  bool
+  isRouterSpecific(const ndn::Name& name) const
+  {
+    return hasComponents(name, "nlsr", "DV") || hasComponents(name, "nlsr", "INFO");
+  }
+
+  void
+  forwardInterest(Router& from, Router& to, const ndn::Interest& interest)
+  {
+    m_scheduler.schedule(m_options.linkDelay, [this, &from, &to, interest] {
+      if (!isLinkUp(from.index, to.index)) {
+        return;
+      }
+      m_pit[to.index].push_back({interest, from.index,
+                                 time::steady_clock::now() + interest.getInterestLifetime()});
+      deliver(to, [&to, &interest] { to.face.receive(interest); });
+    });
+  }
+
+  void
+  onSendData(Router& router, const ndn::Data& data)
+  {
+    count(router, data.getName(), data.wireEncode().size(), false);
+
+    auto now = time::steady_clock::now();
+    auto& pit = m_pit[router.index];
+    for (auto it = pit.begin(); it != pit.end();) {
+      if (it->expiry < now) {
+        it = pit.erase(it);
+        continue;
+      }
+      if (!it->interest.matchesData(data)) {
+        ++it;
+        continue;
+      }
+
+      Router& requester = *m_routers[it->from];
+      m_scheduler.schedule(m_options.linkDelay, [this, &router, &requester, data] {
+        if (isLinkUp(router.index, requester.index)) {
+          deliver(requester, [&requester, &data] { requester.face.receive(data); });
+        }
+      });
+      it = pit.erase(it);
+    }
+  }
+
+  /*! \brief Answers the faces dataset as the local forwarder would.
+   *
+   *  Prefix registrations are answered by the DummyClientFace itself; the
+   *  other commands are left unanswered, which the routers tolerate.
+   */
+  void
+  answerFaceDataset(Router& router, const ndn::Interest& interest)
+  {
+    ndn::encoding::EncodingBuffer buffer;
+    for (const auto& face : router.faceIds) {
+      ndn::nfd::FaceStatus status;
+      status.setFaceId(face.second)
+            .setRemoteUri(Router::makeFaceUri(face.first).toString())
+            .setLocalUri("udp4://127.0.0.1:6363");
+      status.wireEncode(buffer);
+    }
+
+    auto data = std::make_shared<ndn::Data>(ndn::Name(interest.getName())
+                                              .appendVersion().appendSegment(0));
+    data->setFinalBlock(data->getName()[-1]);
+    data->setContent(buffer.buf(), buffer.size());
+    m_keyChain.sign(*data, ndn::security::signingWithSha256());
+
+    deliver(router, [&router, &data] { router.face.receive(*data); });
+  }
+
+  void
+  deliver(Router& router, const std::function<void()>& receive)
+  {
+    auto before = getThreadCpuTime();
+    receive();
+    router.counters.cpuTime += getThreadCpuTime() - before;
+  }
+
+  bool
+  isLinkUp(size_t a, size_t b) const
+  {
+    for (const auto& link : m_links) {
+      if (((link.a == a && link.b == b) || (link.a == b && link.b == a)) && link.isUp) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*! \brief Whether every router has routes to exactly the routers it can reach.
+   */
+  bool
+  hasExpectedRoutes() const
+  {
+    for (const auto& router : m_routers) {
+      std::set<ndn::Name> expected;
+      for (size_t reachable : findReachable(router->index)) {
+        if (reachable != router->index) {
+          expected.insert(m_routers[reachable]->getName());
+        }
+      }
+
+      std::set<ndn::Name> actual;
+      for (const auto& entry : router->nlsr->m_routingTable.getRoutingTableEntry()) {
+        actual.insert(entry.getDestination());
+      }
+
+      if (actual != expected) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::set<size_t>
+  findReachable(size_t source) const
+  {
+    std::set<size_t> reachable{source};
+    std::queue<size_t> queue;
+    queue.push(source);
+    while (!queue.empty()) {
+      size_t current = queue.front();
+      queue.pop();
+      for (const auto& link : m_links) {
+        if (!link.isUp) {
+          continue;
+        }
+        size_t next = link.a == current ? link.b : link.b == current ? link.a : current;
+        if (next != current && reachable.insert(next).second) {
+          queue.push(next);
+        }
+      }
+    }
+    return reachable;
+  }
+
+  void
+  advanceClocks(time::nanoseconds tick)
+  {
+    m_steadyClock->advance(tick);
+    m_systemClock->advance(tick);
+
+    if (m_ioService.stopped()) {
+      m_ioService.reset();
+    }
+    m_ioService.poll();
+  }
+
+private:
+  struct PitEntry
+  {
+    ndn::Interest interest;
+    size_t from;
+    time::steady_clock::TimePoint expiry;
+  };
+
+  std::shared_ptr<time::UnitTestSteadyClock> m_steadyClock;
+  std::shared_ptr<time::UnitTestSystemClock> m_systemClock;
+  boost::asio::io_service m_ioService;
+  ndn::KeyChain m_keyChain;
+  ndn::Scheduler m_scheduler;
+
+  std::vector<Link> m_links;
+  const Options m_options;
+  boost::filesystem::path m_stateDir;
+  std::vector<std::unique_ptr<Router>> m_routers;
+  // Interests each router received from its neighbors and has not answered yet
+  std::vector<std::list<PitEntry>> m_pit;
+};
+
+static std::vector<Link>
+makeTopology(const std::string& topology, size_t nRouters, double cost)
+{
+  std::vector<Link> links;
+  if (topology == "line" || topology == "ring") {
+    for (size_t i = 0; i + 1 < nRouters; ++i) {
+      links.push_back({i, i + 1, cost, true});
+    }
+    if (topology == "ring" && nRouters > 2) {
+      links.push_back({nRouters - 1, 0, cost, true});
+    }
+  }
+  else if (topology == "grid") {
+    size_t width = static_cast<size_t>(std::ceil(std::sqrt(nRouters)));
+    for (size_t i = 0; i < nRouters; ++i) {
+      if ((i + 1) % width != 0 && i + 1 < nRouters) {
+        links.push_back({i, i + 1, cost, true});
+      }
+      if (i + width < nRouters) {
+        links.push_back({i, i + width, cost, true});
+      }
+    }
+  }
+  else if (topology == "full") {
+    for (size_t i = 0; i < nRouters; ++i) {
+      for (size_t j = i + 1; j < nRouters; ++j) {
+        links.push_back({i, j, cost, true});
+      }
+    }
+  }
+  else {
+    // One link per line: <router> <router> [cost]
+    std::ifstream file(topology);
+    if (!file) {
+      throw std::invalid_argument("Unknown topology " + topology);
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream is(line);
+      Link link{0, 0, cost, true};
+      if (!(is >> link.a >> link.b)) {
+        continue;
+      }
+      is >> link.cost;
+      if (link.a >= nRouters || link.b >= nRouters || link.a == link.b) {
+        throw std::invalid_argument("Bad link in " + topology + ": " + line);
+      }
+      links.push_back(link);
+    }
+  }
+  return links;
+}
+
+static void
+printPhase(std::ostream& os, const std::string& phase,
+           const ndn::optional<time::nanoseconds>& convergenceTime,
+           const std::vector<Counters>& counters)
+{
+  Counters total;
+  for (const auto& c : counters) {
+    total += c;
+  }
+
+  os << "== " << phase << "\n";
+  if (convergenceTime) {
+    os << "  convergence time:  "
+       << time::duration_cast<time::milliseconds>(*convergenceTime).count() << " ms\n";
+  }
+  else {
+    os << "  convergence time:  not converged\n";
+  }
+  os << "  DV interests/data: " << total.nDvInterests << " / " << total.nDvData
+     << " (" << total.nDvBytes << " bytes)\n"
+     << "  hello interests/data: " << total.nHelloInterests << " / " << total.nHelloData << "\n"
+     << "  other packets:     " << total.nOtherPackets << "\n"
+     << "  bytes sent:        " << total.nBytes << "\n"
+     << "  CPU time:          "
+     << time::duration_cast<time::microseconds>(total.cpuTime).count() << " us\n";
+
+  os << "  router  DV-int  DV-data  DV-bytes  bytes  cpu-us\n";
+  for (size_t i = 0; i < counters.size(); ++i) {
+    const Counters& c = counters[i];
+    os << "  " << std::setw(6) << i
+       << std::setw(8) << c.nDvInterests
+       << std::setw(9) << c.nDvData
+       << std::setw(10) << c.nDvBytes
+       << std::setw(7) << c.nBytes
+       << std::setw(8) << time::duration_cast<time::microseconds>(c.cpuTime).count() << "\n";
+  }
+  os << std::flush;
+}
+
+static int
+main(int argc, char** argv)
+{
+  namespace po = boost::program_options;
+
+  size_t nRouters = 8;
+  std::string topology = "ring";
+  double linkCost = 10;
+  std::vector<size_t> failedLinks;
+  ConvergenceBenchmark::Options options;
+  uint32_t linkDelay = 10;
+  uint32_t settleTime = 10;
+  uint32_t timeout = 600;
+
+  po::options_description description("Options");
+  description.add_options()
+    ("help,h", "print this help message")
+    ("routers,n", po::value<size_t>(&nRouters)->default_value(nRouters), "number of routers")
+    ("topology,t", po::value<std::string>(&topology)->default_value(topology),
+     "line, ring, grid, full, or a file with one '<router> <router> [cost]' link per line")
+    ("cost", po::value<double>(&linkCost)->default_value(linkCost), "default link cost")
+    ("fail,f", po::value<std::vector<size_t>>(&failedLinks),
+     "index of a link to fail and then restore; repeatable")
+    ("link-delay", po::value<uint32_t>(&linkDelay)->default_value(linkDelay),
+     "one-way link delay in milliseconds")
+    ("settle", po::value<uint32_t>(&settleTime)->default_value(settleTime),
+     "seconds without routing changes before a phase is considered converged")
+    ("timeout", po::value<uint32_t>(&timeout)->default_value(timeout),
+     "seconds after which a phase is reported as not converged")
+    ("hello-interval", po::value<uint32_t>(&options.helloInterval)
+       ->default_value(options.helloInterval), "hello interval in seconds")
+    ("hello-retries", po::value<uint32_t>(&options.helloRetries)
+       ->default_value(options.helloRetries), "hello retries before a neighbor is down")
+    ;
+
+  po::variables_map vm;
+  try {
+    po::store(po::parse_command_line(argc, argv, description), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << "\n" << description << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    std::cout << "Usage: " << argv[0] << " [options]\n" << description << std::endl;
+    return 0;
+  }
+
+  std::vector<Link> links;
+  try {
+    links = makeTopology(topology, nRouters, linkCost);
+  }
+  catch (const std::invalid_argument& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+  if (failedLinks.empty() && !links.empty()) {
+    failedLinks.push_back(0);
+  }
+
+  options.linkDelay = time::milliseconds(linkDelay);
+  options.settleTime = time::seconds(settleTime);
+  options.timeout = time::seconds(timeout);
+
+  std::cout << nRouters << " routers, " << links.size() << " links (" << topology << ")\n";
+
+  ConvergenceBenchmark benchmark(nRouters, std::move(links), options);
+  auto convergenceTime = benchmark.runUntilConverged();
+  printPhase(std::cout, "initial", convergenceTime, benchmark.takeCounters());
+
+  for (size_t linkIndex : failedLinks) {
+    const Link& link = benchmark.getLink(linkIndex);
+    std::string linkName = std::to_string(link.a) + "-" + std::to_string(link.b);
+
+    benchmark.setLinkState(linkIndex, false);
+    convergenceTime = benchmark.runUntilConverged();
+    printPhase(std::cout, "link " + linkName + " down", convergenceTime, benchmark.takeCounters());
+
+    benchmark.setLinkState(linkIndex, true);
+    convergenceTime = benchmark.runUntilConverged();
+    printPhase(std::cout, "link " + linkName + " up", convergenceTime, benchmark.takeCounters());
+  }
+
+  return 0;
+}
+
+} // namespace tests
+} // namespace nlsr
+
+int
+main(int argc, char** argv)
+{
+  return nlsr::tests::main(argc, argv);
+}
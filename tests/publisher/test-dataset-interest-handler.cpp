@@ -93,6 +93,23 @@ BOOST_AUTO_TEST_CASE(Localhost)
   processDatasetInterest(face,
     [] (const ndn::Block& block) {
       return block.type() == ndn::tlv::nlsr::RoutingTable; });
+
+  // Request neighbors
+  Adjacent neighbor("/RouterA/adjacency1", ndn::FaceUri("udp://face-1"), 10,
+                    Adjacent::STATUS_ACTIVE, 0, 0);
+  neighbor.setHelloInterval(120_s);
+  conf.getAdjacencyList().insert(neighbor);
+
+  face.receive(ndn::Interest("/localhost/nlsr/neighbors").setCanBePrefix(true));
+  processDatasetInterest(face,
+    [] (const ndn::Block& block) {
+      if (block.type() != ndn::tlv::nlsr::NeighborStatus) {
+        return false;
+      }
+      block.parse();
+      return ndn::Name(block.get(ndn::tlv::Name)) == "/RouterA/adjacency1" &&
+             ndn::readNonNegativeInteger(block.get(ndn::tlv::nlsr::HelloInterval)) == 120;
+    });
 }
 
 BOOST_AUTO_TEST_CASE(RouterName)
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/routing-table-calculator.hpp"
+
+#include "adjacency-list.hpp"
+#include "lsdb.hpp"
+#include "nlsr.hpp"
+#include "../test-common.hpp"
+#include "route/routing-table.hpp"
+#include "adjacent.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace nlsr {
+namespace test {
+
+static const ndn::time::system_clock::TimePoint MAX_TIME =
+  ndn::time::system_clock::TimePoint::max();
+
+class DvCalculatorFixture : public BaseFixture
+{
+public:
+  DvCalculatorFixture()
+    : face(m_ioService, m_keyChain)
+    , conf(face, m_keyChain)
+    , confProcessor(conf)
+    , nlsr(face, m_keyChain, conf)
+    , routingTable(nlsr.m_routingTable)
+    , lsdb(nlsr.m_lsdb)
+  {
+    setUpTopology();
+  }
+
+  // This router has neighbors B and C, which advertise anchors D and E
+  void
+  setUpTopology()
+  {
+    Adjacent b(ROUTER_B_NAME, ndn::FaceUri(ROUTER_B_FACE), 10, Adjacent::STATUS_ACTIVE, 0, 0);
+    Adjacent c(ROUTER_C_NAME, ndn::FaceUri(ROUTER_C_FACE), 20, Adjacent::STATUS_ACTIVE, 0, 0);
+
+    AdjacencyList& adjacencyList = conf.getAdjacencyList();
+    adjacencyList.insert(b);
+    adjacencyList.insert(c);
+
+    lsdb.installLsa(std::make_shared<AdjLsa>(conf.getRouterPrefix(), 1, MAX_TIME, 2,
+                                             adjacencyList));
+
+    lsdb.installLsa(makeMidstLsa(ROUTER_B_NAME, 1, 5, 50));
+
+    MidstPrefixList mplC;
+    mplC.insert("/prefix/d", 1, ROUTER_D_NAME, 1);
+    lsdb.installLsa(std::make_shared<MidstLsa>(ROUTER_C_NAME, 1, MAX_TIME, mplC));
+  }
+
+  std::shared_ptr<MidstLsa>
+  makeMidstLsa(const ndn::Name& origin, uint64_t seqNo, double distanceD, double distanceE)
+  {
+    MidstPrefixList mpl;
+    mpl.insert("/prefix/d", distanceD, ROUTER_D_NAME, 1);
+    mpl.insert("/prefix/e", distanceE, ROUTER_E_NAME, 1);
+    return std::make_shared<MidstLsa>(origin, seqNo, MAX_TIME, mpl);
+  }
+
+  void
+  checkRoute(const ndn::Name& dest, const std::string& faceUri, double cost)
+  {
+    RoutingTableEntry* entry = routingTable.findRoutingTableEntry(dest);
+    BOOST_REQUIRE(entry != nullptr);
+
+    const NexthopList& nextHops = entry->getNexthopList();
+    BOOST_REQUIRE_EQUAL(nextHops.size(), 1);
+    BOOST_CHECK_EQUAL(nextHops.getNextHops().begin()->getConnectingFaceUri(), faceUri);
+    BOOST_CHECK_EQUAL(nextHops.getNextHops().begin()->getRouteCost(), cost);
+  }
+
+public:
+  ndn::util::DummyClientFace face;
+  ConfParameter conf;
+  DummyConfFileProcessor confProcessor;
+  Nlsr nlsr;
+
+  RoutingTable& routingTable;
+  Lsdb& lsdb;
+
+  static const ndn::Name ROUTER_B_NAME;
+  static const ndn::Name ROUTER_C_NAME;
+  static const ndn::Name ROUTER_D_NAME;
+  static const ndn::Name ROUTER_E_NAME;
+
+  static const std::string ROUTER_B_FACE;
+  static const std::string ROUTER_C_FACE;
+};
+
+const ndn::Name DvCalculatorFixture::ROUTER_B_NAME = "/ndn/site/%C1.Router/b";
+const ndn::Name DvCalculatorFixture::ROUTER_C_NAME = "/ndn/site/%C1.Router/c";
+const ndn::Name DvCalculatorFixture::ROUTER_D_NAME = "/ndn/site/%C1.Router/d";
+const ndn::Name DvCalculatorFixture::ROUTER_E_NAME = "/ndn/site/%C1.Router/e";
+
+const std::string DvCalculatorFixture::ROUTER_B_FACE = "udp4://10.0.0.2";
+const std::string DvCalculatorFixture::ROUTER_C_FACE = "udp4://10.0.0.3";
+
+BOOST_FIXTURE_TEST_SUITE(TestDvRoutingCalculator, DvCalculatorFixture)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  DvRoutingCalculator calculator(conf.getRouterPrefix());
+  calculator.calculatePath(routingTable, conf.getAdjacencyList(), lsdb);
+
+  BOOST_CHECK(calculator.isInitialized());
+  checkRoute(ROUTER_B_NAME, ROUTER_B_FACE, 10);
+  checkRoute(ROUTER_C_NAME, ROUTER_C_FACE, 20);
+  // D is reachable through B at 10 + 5 and through C at 20 + 1
+  checkRoute(ROUTER_D_NAME, ROUTER_B_FACE, 15);
+  checkRoute(ROUTER_E_NAME, ROUTER_B_FACE, 60);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateNeighbor)
+{
+  DvRoutingCalculator calculator(conf.getRouterPrefix());
+
+  // Nothing to update before the first calculation
+  auto lsaB = makeMidstLsa(ROUTER_B_NAME, 2, 30, 50);
+  BOOST_CHECK(!calculator.updateNeighbor(ROUTER_B_NAME, lsaB.get(),
+                                         routingTable, conf.getAdjacencyList()));
+
+  calculator.calculatePath(routingTable, conf.getAdjacencyList(), lsdb);
+
+  // Same vector, no route changes
+  BOOST_CHECK(!calculator.updateNeighbor(ROUTER_B_NAME, makeMidstLsa(ROUTER_B_NAME, 2, 5, 50).get(),
+                                         routingTable, conf.getAdjacencyList()));
+
+  BOOST_CHECK(calculator.updateNeighbor(ROUTER_B_NAME, makeMidstLsa(ROUTER_B_NAME, 3, 30, 50).get(),
+                                        routingTable, conf.getAdjacencyList()));
+  checkRoute(ROUTER_D_NAME, ROUTER_C_FACE, 21);
+  checkRoute(ROUTER_E_NAME, ROUTER_B_FACE, 60);
+
+  // Losing B's vector leaves E unreachable, but B itself is still a neighbor
+  BOOST_CHECK(calculator.updateNeighbor(ROUTER_B_NAME, nullptr,
+                                        routingTable, conf.getAdjacencyList()));
+  BOOST_CHECK(routingTable.findRoutingTableEntry(ROUTER_E_NAME) == nullptr);
+  checkRoute(ROUTER_B_NAME, ROUTER_B_FACE, 10);
+  checkRoute(ROUTER_D_NAME, ROUTER_C_FACE, 21);
+}
+
+BOOST_AUTO_TEST_CASE(TieBreak)
+{
+  // B and C both reach D at a cost of 21
+  DvRoutingCalculator calculator(conf.getRouterPrefix());
+  calculator.calculatePath(routingTable, conf.getAdjacencyList(), lsdb);
+  calculator.updateNeighbor(ROUTER_B_NAME, makeMidstLsa(ROUTER_B_NAME, 2, 11, 50).get(),
+                            routingTable, conf.getAdjacencyList());
+
+  checkRoute(ROUTER_D_NAME, ROUTER_B_FACE, 21);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -24,6 +24,7 @@
 #include "adjacency-list.hpp"
 #include "conf-parameter.hpp"
 
+#include <ndn-cxx/mgmt/nfd/control-response.hpp>
 #include <ndn-cxx/util/dummy-client-face.hpp>
 
 namespace nlsr {
@@ -312,6 +313,41 @@ BOOST_FIXTURE_TEST_CASE(ScheduleFibEntryRefresh, FibFixture)
   this->advanceClocks(ndn::time::milliseconds(10), 1);
 }
 
+BOOST_AUTO_TEST_CASE(StrategyCommandWindow)
+{
+  const ndn::Name strategyChoiceSet("/localhost/nfd/strategy-choice/set");
+  auto countStrategyCommands = [&] {
+    return static_cast<size_t>(std::count_if(interests.begin(), interests.end(),
+      [&] (const ndn::Interest& interest) {
+        return strategyChoiceSet.isPrefixOf(interest.getName());
+      }));
+  };
+
+  for (int i = 0; i < 20; ++i) {
+    fib->setStrategy(ndn::Name("/ndn/site").appendNumber(i), Fib::BEST_ROUTE_V2_STRATEGY, 0);
+  }
+  this->advanceClocks(ndn::time::milliseconds(10));
+
+  // Only a window of commands is outstanding, the rest wait in the queue
+  BOOST_CHECK_EQUAL(countStrategyCommands(), Fib::STRATEGY_COMMAND_WINDOW);
+  BOOST_CHECK_EQUAL(fib->m_strategyCommands.size(), 20 - Fib::STRATEGY_COMMAND_WINDOW);
+
+  // Each reply lets a queued command go out
+  ndn::nfd::ControlParameters parameters;
+  ndn::Name::Component verb;
+  extractParameters(interests.front(), verb, parameters, "/localhost/nfd/strategy-choice");
+  auto reply = std::make_shared<ndn::Data>(interests.front().getName());
+  reply->setFreshnessPeriod(ndn::time::seconds(1));
+  reply->setContent(ndn::nfd::ControlResponse(200, "OK").setBody(parameters.wireEncode())
+                                                         .wireEncode());
+  m_keyChain.sign(*reply);
+  face->receive(*reply);
+  this->advanceClocks(ndn::time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(countStrategyCommands(), Fib::STRATEGY_COMMAND_WINDOW + 1);
+  BOOST_CHECK_EQUAL(fib->m_nOutstandingStrategyCommands, Fib::STRATEGY_COMMAND_WINDOW);
+}
+
 BOOST_AUTO_TEST_CASE(ShouldNotRefreshNeighborRoute) // #4799
 {
   NextHop hop1;
@@ -67,7 +67,7 @@ BOOST_AUTO_TEST_SUITE(TestNamePrefixTable)
 
 BOOST_FIXTURE_TEST_CASE(Bupt, NamePrefixTableFixture)
 {
-  rt.m_routingCalcInterval = 0_s;
+  rt.m_routingCalcThrottle = util::ExponentialThrottle(0_s, 1_s, 1_s);
 
   Adjacent thisRouter(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1"), 0, Adjacent::STATUS_ACTIVE, 0, 0);
 
@@ -134,6 +134,9 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableOutputStream, RoutingTableFixture)
 
 BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, RoutingTableFixture)
 {
+  // The steps below are timed for calculations that start 15 seconds after a change
+  rt.m_routingCalcThrottle = util::ExponentialThrottle(15_s, 15_s, 60_s);
+
   ndn::time::system_clock::TimePoint testTimePoint = ndn::time::system_clock::now() + 3600_s;
   ndn::Name router2("/router2");
   AdjLsa adjLsa(router2, 12, testTimePoint, 2, conf.getAdjacencyList());
@@ -204,11 +207,46 @@ BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, RoutingTableFixture)
   // Emulate HelloProtocol neighbor down
   conf.getAdjacencyList().setStatusOfNeighbor("/router5", Adjacent::STATUS_INACTIVE);
   rt.scheduleRoutingTableCalculation();
-  advanceClocks(15_s);
+  // Right after the previous calculation, so it is held back for longer
+  advanceClocks(60_s);
   BOOST_CHECK_EQUAL(rt.m_rTable.size(), 0);
   BOOST_CHECK(!rt.m_wire.isValid());
 }
 
+BOOST_FIXTURE_TEST_CASE(RoutingCalcThrottle, RoutingTableFixture)
+{
+  // An isolated request waits for the initial delay only
+  rt.scheduleRoutingTableCalculation();
+  BOOST_CHECK(rt.m_isRouteCalculationScheduled);
+  advanceClocks(10_ms, 100_ms);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+
+  // A request right after that calculation waits for the routing calculation interval
+  rt.scheduleRoutingTableCalculation();
+  advanceClocks(1_s, 14);
+  BOOST_CHECK(rt.m_isRouteCalculationScheduled);
+  advanceClocks(1_s);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+  BOOST_CHECK_EQUAL(rt.m_routingCalcThrottle.getNBackoffs(), 1);
+
+  // The next one waits twice as long, and requests while it is pending are merged into it
+  rt.scheduleRoutingTableCalculation();
+  advanceClocks(1_s, 5);
+  rt.scheduleRoutingTableCalculation();
+  advanceClocks(1_s, 24);
+  BOOST_CHECK(rt.m_isRouteCalculationScheduled);
+  advanceClocks(1_s);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+  BOOST_CHECK_EQUAL(rt.m_routingCalcThrottle.getNBackoffs(), 2);
+
+  // After a quiet period, calculations are back to the initial delay
+  advanceClocks(10_s, 12);
+  rt.scheduleRoutingTableCalculation();
+  advanceClocks(10_ms, 100_ms);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+  BOOST_CHECK_EQUAL(rt.m_routingCalcThrottle.getNBackoffs(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "security/verified-key-cache.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/security/certificate-fetcher-offline.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/security/validator-config.hpp>
+
+namespace nlsr {
+namespace test {
+
+class VerifiedKeyCacheFixture : public UnitTestTimeFixture
+{
+public:
+  VerifiedKeyCacheFixture()
+    : validator(std::make_unique<ndn::security::CertificateFetcherOffline>())
+    , cache(validator, ndn::time::seconds(60))
+    , routerId(addIdentity("/ndn/site/%C1.Router/router1"))
+  {
+    validator.load(R"CONF(
+      rule
+      {
+        id "hello"
+        for data
+        checker
+        {
+          type hierarchical
+          sig-type ecdsa-sha256
+        }
+      }
+    )CONF", "test-verified-key-cache");
+    validator.loadAnchor("router", routerId.getDefaultKey().getDefaultCertificate());
+  }
+
+  ndn::Data
+  makeData(const ndn::Name& name)
+  {
+    ndn::Data data(name);
+    data.setFreshnessPeriod(ndn::time::seconds(10));
+    m_keyChain.sign(data, ndn::security::signingByIdentity(routerId));
+    return data;
+  }
+
+  void
+  validate(const ndn::Data& data, const ndn::Name& context)
+  {
+    cache.validate(data, context,
+                   [this] (const ndn::Data&) { ++nValidated; },
+                   [this] (const ndn::Data&, const ndn::security::ValidationError&) { ++nFailed; });
+  }
+
+public:
+  ndn::security::ValidatorConfig validator;
+  security::VerifiedKeyCache cache;
+  ndn::security::Identity routerId;
+
+  const ndn::Name context = "/ndn/site/%C1.Router/router1/nlsr/INFO/router2";
+  int nValidated = 0;
+  int nFailed = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestVerifiedKeyCache, VerifiedKeyCacheFixture)
+
+BOOST_AUTO_TEST_CASE(HitAfterValidation)
+{
+  validate(makeData(ndn::Name(context).appendVersion(1)), context);
+  BOOST_CHECK_EQUAL(nValidated, 1);
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 1);
+  BOOST_CHECK_EQUAL(cache.getHitCount(), 0);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  validate(makeData(ndn::Name(context).appendVersion(2)), context);
+  BOOST_CHECK_EQUAL(nValidated, 2);
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 1);
+  BOOST_CHECK_EQUAL(cache.getHitCount(), 1);
+
+  // The same key under another context has to go through the Validator again
+  ndn::Name otherContext("/ndn/site/%C1.Router/router1/nlsr/DV");
+  validate(makeData(ndn::Name(otherContext).appendNumber(1)), otherContext);
+  BOOST_CHECK_EQUAL(nValidated, 3);
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 2);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(BadSignature)
+{
+  validate(makeData(ndn::Name(context).appendVersion(1)), context);
+  BOOST_CHECK_EQUAL(nValidated, 1);
+
+  ndn::Data tampered = makeData(ndn::Name(context).appendVersion(2));
+  tampered.setContent(ndn::makeStringBlock(ndn::tlv::Content, "tampered"));
+
+  validate(tampered, context);
+  BOOST_CHECK_EQUAL(nValidated, 1);
+  BOOST_CHECK_EQUAL(nFailed, 1);
+  BOOST_CHECK_EQUAL(cache.getHitCount(), 0);
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 2);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  validate(makeData(ndn::Name(context).appendVersion(1)), context);
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 1);
+
+  advanceClocks(ndn::time::seconds(30));
+  validate(makeData(ndn::Name(context).appendVersion(2)), context);
+  BOOST_CHECK_EQUAL(cache.getHitCount(), 1);
+
+  advanceClocks(ndn::time::seconds(31));
+  validate(makeData(ndn::Name(context).appendVersion(3)), context);
+  BOOST_CHECK_EQUAL(cache.getHitCount(), 1);
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 2);
+  BOOST_CHECK_EQUAL(nValidated, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -139,6 +139,37 @@ BOOST_AUTO_TEST_CASE(AdjLsaIsNotBuildable)
   BOOST_CHECK(!adjacencies.isAdjLsaBuildable(conf.getInterestRetryNumber()));
 }
 
+BOOST_AUTO_TEST_CASE(FindByFaceIdAndUri)
+{
+  AdjacencyList adjacencies;
+  adjacencies.insert(Adjacent("/router/A", ndn::FaceUri("udp4://10.0.0.1:6363"),
+                              10, Adjacent::STATUS_INACTIVE, 0, 0));
+  adjacencies.insert(Adjacent("/router/B", ndn::FaceUri("udp4://10.0.0.2:6363"),
+                              10, Adjacent::STATUS_INACTIVE, 0, 0));
+
+  auto adjacentA = adjacencies.findAdjacent(ndn::FaceUri("udp4://10.0.0.1:6363"));
+  BOOST_REQUIRE(adjacentA != adjacencies.end());
+  BOOST_CHECK_EQUAL(adjacentA->getName(), "/router/A");
+  BOOST_CHECK(adjacencies.findAdjacent(ndn::FaceUri("udp4://10.0.0.3:6363")) == adjacencies.end());
+
+  adjacencies.setFaceId(adjacentA, 256);
+  BOOST_CHECK(adjacencies.findAdjacent(256) == adjacentA);
+  BOOST_CHECK_EQUAL(adjacencies.getFaceId(ndn::FaceUri("udp4://10.0.0.1:6363")), 256);
+
+  // A copy has its own index over its own adjacencies
+  AdjacencyList copy(adjacencies);
+  adjacencies.setFaceId(adjacentA, 257);
+  BOOST_CHECK(adjacencies.findAdjacent(256) == adjacencies.end());
+  auto copiedA = copy.findAdjacent(256);
+  BOOST_REQUIRE(copiedA != copy.end());
+  BOOST_CHECK_EQUAL(copiedA->getName(), "/router/A");
+  BOOST_CHECK(copy.findAdjacent(257) == copy.end());
+
+  // Iteration keeps the insertion order
+  BOOST_CHECK_EQUAL(copy.getAdjList().front().getName(), "/router/A");
+  BOOST_CHECK_EQUAL(copy.getAdjList().back().getName(), "/router/B");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
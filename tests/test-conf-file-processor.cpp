@@ -44,6 +44,7 @@ const std::string SECTION_GENERAL =
   "  router-dead-interval 86400\n"
   "  sync-protocol psync\n"
   "  sync-interest-lifetime 10000\n"
+  "  sync-ibf-size 400\n"
   "  state-dir /tmp\n"
   "}\n\n";
 
@@ -53,7 +54,15 @@ const std::string SECTION_NEIGHBORS =
   "  hello-retries 3\n"
   "  hello-timeout 1\n"
   "  hello-interval  60\n\n"
+  "  hello-interval-max 480\n"
+  "  link-cost-from-rtt on\n"
+  "  rtt-cost-quantum 2\n"
+  "  rtt-cost-hysteresis 10\n"
+  "  probe-interval 200\n"
+  "  probe-detect-multiplier 4\n"
   "  adj-lsa-build-interval 10\n"
+  "  adj-lsa-build-initial-delay 500\n"
+  "  adj-lsa-build-max-interval 120\n"
   "  neighbor\n"
   "  {\n"
   "    name /ndn/memphis.edu/cs/castor\n"
@@ -97,6 +106,8 @@ const std::string SECTION_FIB =
   "{\n"
   "   max-faces-per-prefix 3\n"
   "   routing-calc-interval 9\n"
+  "   routing-calc-initial-delay 200\n"
+  "   routing-calc-max-interval 90\n"
   "}\n\n";
 
 const std::string SECTION_ADVERTISING =
@@ -174,14 +185,23 @@ BOOST_AUTO_TEST_CASE(LinkState)
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(), ndn::time::seconds(3));
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), 86400);
   BOOST_CHECK_EQUAL(conf.getSyncInterestLifetime(), ndn::time::milliseconds(10000));
+  BOOST_CHECK_EQUAL(conf.getSyncIbfSize(), 400);
   BOOST_CHECK_EQUAL(conf.getStateFileDir(), "/tmp");
 
   // Neighbors
   BOOST_CHECK_EQUAL(conf.getInterestRetryNumber(), 3);
   BOOST_CHECK_EQUAL(conf.getInterestResendTime(), 1);
   BOOST_CHECK_EQUAL(conf.getInfoInterestInterval(), 60);
+  BOOST_CHECK_EQUAL(conf.getHelloIntervalMax(), 480);
+  BOOST_CHECK(conf.isRttLinkCostEnabled());
+  BOOST_CHECK_EQUAL(conf.getRttCostQuantum(), ndn::time::milliseconds(2));
+  BOOST_CHECK_EQUAL(conf.getRttCostHysteresis(), 10);
+  BOOST_CHECK_EQUAL(conf.getProbeInterval(), ndn::time::milliseconds(200));
+  BOOST_CHECK_EQUAL(conf.getProbeDetectMultiplier(), 4);
 
   BOOST_CHECK_EQUAL(conf.getAdjLsaBuildInterval(), 10);
+  BOOST_CHECK_EQUAL(conf.getAdjLsaBuildInitialDelay(), 500);
+  BOOST_CHECK_EQUAL(conf.getAdjLsaBuildMaxInterval(), 120);
 
   BOOST_CHECK(conf.getAdjacencyList().isNeighbor("/ndn/memphis.edu/cs/mira"));
   BOOST_CHECK(conf.getAdjacencyList().isNeighbor("/ndn/memphis.edu/cs/castor"));
@@ -203,6 +223,8 @@ BOOST_AUTO_TEST_CASE(LinkState)
   // FIB
   BOOST_CHECK_EQUAL(conf.getMaxFacesPerPrefix(), 3);
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(), 9);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialDelay(), 200);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcMaxInterval(), 90);
 
   // Advertising
   BOOST_CHECK_EQUAL(conf.getNamePrefixList().size(), 2);
@@ -258,6 +280,7 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   commentOut("lsa-refresh-time", config);
   commentOut("lsa-interest-lifetime", config);
   commentOut("router-dead-interval", config);
+  commentOut("sync-ibf-size", config);
 
   BOOST_CHECK(processConfigurationString(config));
 
@@ -265,6 +288,7 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(),
                     static_cast<ndn::time::seconds>(LSA_INTEREST_LIFETIME_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), (2 * conf.getLsaRefreshTime()));
+  BOOST_CHECK_EQUAL(conf.getSyncIbfSize(), static_cast<uint32_t>(SYNC_IBF_SIZE_DEFAULT));
 
   BOOST_CHECK(conf.m_confFileName != conf.getConfFileNameDynamic());
   conf.m_confFileName = "/tmp/nlsr.conf";
@@ -280,15 +304,35 @@ BOOST_AUTO_TEST_CASE(DefaultValuesNeighbors)
   commentOut("hello-timeout", config);
   commentOut("hello-interval", config);
   commentOut("first-hello-interval", config);
+  commentOut("hello-interval-max", config);
+  commentOut("link-cost-from-rtt", config);
+  commentOut("rtt-cost-quantum", config);
+  commentOut("rtt-cost-hysteresis", config);
+  commentOut("probe-interval", config);
+  commentOut("probe-detect-multiplier", config);
   commentOut("adj-lsa-build-interval", config);
+  commentOut("adj-lsa-build-initial-delay", config);
+  commentOut("adj-lsa-build-max-interval", config);
 
   BOOST_CHECK_EQUAL(processConfigurationString(config), true);
 
   BOOST_CHECK_EQUAL(conf.getInterestRetryNumber(), static_cast<uint32_t>(HELLO_RETRIES_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getInterestResendTime(), static_cast<uint32_t>(HELLO_TIMEOUT_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getInfoInterestInterval(), static_cast<uint32_t>(HELLO_INTERVAL_DEFAULT));
+  // Without a maximum, the hello interval does not back off
+  BOOST_CHECK_EQUAL(conf.getHelloIntervalMax(), conf.getInfoInterestInterval());
+  BOOST_CHECK(!conf.isRttLinkCostEnabled());
+  BOOST_CHECK_EQUAL(conf.getRttCostQuantum(), ndn::time::milliseconds(RTT_COST_QUANTUM_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRttCostHysteresis(), static_cast<uint32_t>(RTT_COST_HYSTERESIS_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getProbeInterval(), ndn::time::milliseconds(PROBE_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getProbeDetectMultiplier(),
+                    static_cast<uint32_t>(PROBE_DETECT_MULTIPLIER_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getAdjLsaBuildInterval(),
                     static_cast<uint32_t>(ADJ_LSA_BUILD_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getAdjLsaBuildInitialDelay(),
+                    static_cast<uint32_t>(ADJ_LSA_BUILD_INITIAL_DELAY_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getAdjLsaBuildMaxInterval(),
+                    static_cast<uint32_t>(ADJ_LSA_BUILD_MAX_INTERVAL_DEFAULT));
 }
 
 BOOST_AUTO_TEST_CASE(CanonizeNeighbors)
@@ -323,6 +367,8 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
 
   commentOut("max-faces-per-prefix", config);
   commentOut("routing-calc-interval", config);
+  commentOut("routing-calc-initial-delay", config);
+  commentOut("routing-calc-max-interval", config);
 
   BOOST_CHECK_EQUAL(processConfigurationString(config), true);
 
@@ -330,6 +376,10 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
                     static_cast<uint32_t>(MAX_FACES_PER_PREFIX_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(),
                     static_cast<uint32_t>(ROUTING_CALC_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialDelay(),
+                    static_cast<uint32_t>(ROUTING_CALC_INITIAL_DELAY_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcMaxInterval(),
+                    static_cast<uint32_t>(ROUTING_CALC_MAX_INTERVAL_DEFAULT));
 }
 
 BOOST_AUTO_TEST_CASE(DefaultValuesHyperbolic)
@@ -421,6 +471,31 @@ BOOST_AUTO_TEST_CASE(PrefixUpdateValidatorOptional) // Bug #2814
   BOOST_CHECK(processConfigurationString(SECTION_SECURITY));
 }
 
+BOOST_AUTO_TEST_CASE(ReloadClearsVerifiedKeyCache)
+{
+  auto identity = addIdentity("/TestNLSR/identity");
+  auto cert = identity.getDefaultKey().getDefaultCertificate();
+  conf.loadCertToValidator(cert);
+  conf.getVerifiedKeyCache().insert("/TestNLSR/identity/NLSR/INFO", cert.getName());
+  BOOST_REQUIRE_EQUAL(conf.getVerifiedKeyCache().size(), 1);
+
+  const std::string SECTION_SECURITY = R"CONF(
+      security
+      {
+        validator
+        {
+          trust-anchor
+          {
+            type any
+          }
+        }
+      }
+    )CONF";
+
+  BOOST_CHECK(processConfigurationString(SECTION_SECURITY));
+  BOOST_CHECK_EQUAL(conf.getVerifiedKeyCache().size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,522 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dv-message.hpp"
+
+#include "test-common.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace nlsr {
+namespace test {
+
+class DvMessageFixture : public UnitTestTimeFixture
+{
+public:
+  DvMessageFixture()
+    : face(m_ioService, m_keyChain, {true, true})
+    , conf(face, m_keyChain)
+    , confProcessor(conf)
+    , isMidstOn(setMidstState())
+    , lsdb(face, m_keyChain, conf)
+    , dvMessage(face, m_keyChain, conf, lsdb)
+    , neighbor("/ndn/site/%C1.Router/neighbor")
+  {
+    addIdentity(conf.getRouterPrefix());
+    conf.getAdjacencyList().insert(Adjacent(neighbor, ndn::FaceUri("udp4://10.0.0.1"), 10,
+                                            Adjacent::STATUS_ACTIVE, 0, 0));
+    conf.getValidator().load(TRUST_ANY, "config-file-from-string");
+    advanceClocks(10_ms);
+  }
+
+  bool
+  setMidstState()
+  {
+    conf.setMidstState(MIDST_STATE_ON);
+    return true;
+  }
+
+  ndn::Name
+  makeInterestName(uint64_t seqNo)
+  {
+    ndn::Name name(conf.getRouterPrefix());
+    name.append("nlsr").append("DV").appendNumber(seqNo);
+    name.append(neighbor.wireEncode());
+    return name;
+  }
+
+  std::vector<ndn::Interest>
+  getDvInterests() const
+  {
+    ndn::Name prefix(neighbor);
+    prefix.append("nlsr").append("DV");
+    std::vector<ndn::Interest> interests;
+    std::copy_if(face.sentInterests.begin(), face.sentInterests.end(),
+                 std::back_inserter(interests),
+                 [&] (const ndn::Interest& interest) {
+                   return prefix.isPrefixOf(interest.getName());
+                 });
+    return interests;
+  }
+
+  void
+  answerTableRequest(const ndn::Interest& interest, uint64_t seqNo = 1)
+  {
+    // The segment carries the encoded Content block, as DvMessage publishes it
+    ndn::Block content = makeDvTable(seqNo);
+    ndn::Data data(ndn::Name(interest.getName()).appendVersion().appendSegment(0));
+    data.setFinalBlock(ndn::name::Component::fromSegment(0));
+    data.setContent(content.wire(), content.size());
+    m_keyChain.sign(data);
+    face.receive(data);
+    advanceClocks(ndn::time::milliseconds(10));
+  }
+
+  std::shared_ptr<MidstLsa>
+  makeMidstLsa(const ndn::Name& originRouter, uint64_t seqNo)
+  {
+    MidstPrefixList mpl;
+    mpl.insert(ndn::Name(originRouter).append("prefix"), 1, originRouter, 1);
+    return std::make_shared<MidstLsa>(originRouter, seqNo,
+                                      ndn::time::system_clock::now() + ndn::time::seconds(3600),
+                                      mpl);
+  }
+
+  ndn::Block
+  makeLsdbBlock(uint64_t seqNo, const MidstPrefixList& entries)
+  {
+    MidstLsa header(neighbor, seqNo, ndn::time::system_clock::now() + ndn::time::seconds(3600),
+                    MidstPrefixList());
+
+    ndn::Block lsdbBlock(ndn::tlv::nlsr::Lsdb);
+    lsdbBlock.push_back(header.wireEncode());
+    if (!entries.empty()) {
+      lsdbBlock.push_back(entries.wireEncode());
+    }
+    lsdbBlock.encode();
+    return lsdbBlock;
+  }
+
+  ndn::Block
+  makeDvTable(uint64_t seqNo)
+  {
+    ndn::Block content(ndn::tlv::Content);
+    content.push_back(makeLsdbBlock(seqNo, MidstPrefixList()));
+    content.encode();
+    return content;
+  }
+
+  ndn::Block
+  makeDvContent(uint64_t seqNo, const MidstPrefixList& changes, uint64_t since,
+                const std::list<ndn::Name>& withdrawn)
+  {
+    ndn::Block lsdbBlock = makeLsdbBlock(seqNo, changes);
+
+    ndn::Block delta(ndn::tlv::nlsr::DvDelta);
+    delta.push_back(ndn::encoding::makeNonNegativeIntegerBlock(ndn::tlv::nlsr::SequenceNumber,
+                                                               since));
+    for (const auto& name : withdrawn) {
+      delta.push_back(name.wireEncode());
+    }
+    delta.encode();
+
+    ndn::Block content(ndn::tlv::Content);
+    content.push_back(lsdbBlock);
+    content.push_back(delta);
+    content.encode();
+    return content;
+  }
+
+  /*! \brief Fetch this router's table the way \p neighbor does and return
+   *         the MIDST LSA that \p neighbor installed from it.
+   */
+  std::shared_ptr<MidstLsa>
+  fetchTableAsNeighbor()
+  {
+    ndn::util::DummyClientFace face2(m_ioService, m_keyChain, {true, true});
+    face.linkTo(face2);
+
+    ConfParameter conf2(face2, m_keyChain);
+    DummyConfFileProcessor confProcessor2(conf2, SYNC_PROTOCOL_PSYNC, HYPERBOLIC_STATE_OFF,
+                                          "/ndn", "/site", "/%C1.Router/neighbor");
+    conf2.setMidstState(MIDST_STATE_ON);
+    conf2.getValidator().load(TRUST_ANY, "config-file-from-string");
+    addIdentity(conf2.getRouterPrefix());
+
+    Lsdb lsdb2(face2, m_keyChain, conf2);
+    DvMessage dvMessage2(face2, m_keyChain, conf2, lsdb2);
+    advanceClocks(10_ms, 10);
+
+    dvMessage2.expressInterest(conf.getRouterPrefix(), 1);
+    advanceClocks(10_ms, 100);
+    BOOST_CHECK(!dvMessage2.m_neighbors[conf.getRouterPrefix()].isTableRequestPending);
+
+    return lsdb2.findLsa<MidstLsa>(conf.getRouterPrefix());
+  }
+
+public:
+  const std::string TRUST_ANY = R"CONF(
+      trust-anchor
+      {
+        type any
+      }
+    )CONF";
+
+  ndn::util::DummyClientFace face;
+  ConfParameter conf;
+  DummyConfFileProcessor confProcessor;
+  bool isMidstOn;
+  Lsdb lsdb;
+  DvMessage dvMessage;
+  ndn::Name neighbor;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestDvMessage, DvMessageFixture)
+
+BOOST_AUTO_TEST_CASE(PayloadReuse)
+{
+  ndn::Block first = dvMessage.getDvContent(neighbor);
+  // Encoded only once
+  BOOST_CHECK(dvMessage.getDvContent(neighbor).wire() == first.wire());
+
+  // A new MIDST LSA bumps our own sequence number
+  lsdb.installLsa(makeMidstLsa("/ndn/site/%C1.Router/other-router", 1));
+  BOOST_CHECK_NE(dvMessage.getDvContent(neighbor), first);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidateOnRemoval)
+{
+  lsdb.installLsa(makeMidstLsa("/ndn/site/%C1.Router/other-router", 1));
+  ndn::Block first = dvMessage.getDvContent(neighbor);
+  BOOST_CHECK_EQUAL(dvMessage.m_dvPayloads.size(), 1);
+
+  lsdb.removeLsa("/ndn/site/%C1.Router/other-router", Lsa::Type::MIDST);
+  BOOST_CHECK(!dvMessage.m_dvPayloads[neighbor].content.isValid());
+
+  BOOST_CHECK_NE(dvMessage.getDvContent(neighbor), first);
+}
+
+BOOST_AUTO_TEST_CASE(SegmentedTable)
+{
+  // A table that does not fit in a single packet
+  ndn::Name origin("/ndn/site/%C1.Router/router-a");
+  MidstPrefixList mpl;
+  for (int i = 0; i < 1000; ++i) {
+    mpl.insert(ndn::Name(origin).append("prefix").appendNumber(i), 1, origin, 1);
+  }
+  lsdb.installLsa(std::make_shared<MidstLsa>(origin, 1, ndn::time::system_clock::now() +
+                                             ndn::time::seconds(3600), mpl));
+  BOOST_REQUIRE_GT(dvMessage.getDvContent(neighbor).size(), ndn::MAX_NDN_PACKET_SIZE);
+
+  face.sentData.clear();
+  dvMessage.processInterest(makeInterestName(1), ndn::Interest(makeInterestName(1)));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  ndn::Name firstName = face.sentData.front().getName();
+  BOOST_CHECK(firstName.get(-2).isVersion());
+  BOOST_CHECK_EQUAL(firstName.get(-1).toSegment(), 0);
+  BOOST_REQUIRE(face.sentData.front().getFinalBlock());
+  BOOST_CHECK_GT(face.sentData.front().getFinalBlock()->toSegment(), 0);
+
+  // The other segments are served from the published table
+  ndn::Name segmentName = firstName.getPrefix(-1).appendSegment(1);
+  dvMessage.processInterest(segmentName, ndn::Interest(segmentName));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData.back().getName(), segmentName);
+
+  // A segment of another version is not
+  ndn::Name otherVersion = firstName.getPrefix(-2).appendVersion(1).appendSegment(1);
+  dvMessage.processInterest(otherVersion, ndn::Interest(otherVersion));
+  BOOST_CHECK_EQUAL(face.sentData.size(), 2);
+
+  // A MIDST change in the middle of the fetch does not take the segments away
+  lsdb.installLsa(makeMidstLsa("/ndn/site/%C1.Router/other-router", 1));
+  segmentName = firstName.getPrefix(-1).appendSegment(2);
+  dvMessage.processInterest(segmentName, ndn::Interest(segmentName));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK_EQUAL(face.sentData.back().getName(), segmentName);
+
+  // The next request gets the new table
+  advanceClocks(10_ms);
+  dvMessage.processInterest(makeInterestName(1), ndn::Interest(makeInterestName(1)));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 4);
+  BOOST_CHECK_NE(face.sentData.back().getName().getPrefix(-1), firstName.getPrefix(-1));
+}
+
+BOOST_AUTO_TEST_CASE(TableRoundTrip)
+{
+  lsdb.installLsa(makeMidstLsa("/ndn/site/%C1.Router/other-router", 1));
+
+  auto lsa = fetchTableAsNeighbor();
+  BOOST_REQUIRE(lsa != nullptr);
+  BOOST_CHECK_EQUAL(lsa->getSeqNo(), lsdb.getMidstLsaSeqNo());
+  BOOST_CHECK_LT(lsa->getNpl().find("/ndn/site/%C1.Router/other-router/prefix"),
+                 lsa->getNpl().size());
+}
+
+BOOST_AUTO_TEST_CASE(SegmentedTableRoundTrip)
+{
+  ndn::Name origin("/ndn/site/%C1.Router/router-a");
+  MidstPrefixList mpl;
+  for (int i = 0; i < 1000; ++i) {
+    mpl.insert(ndn::Name(origin).append("prefix").appendNumber(i), 1, origin, 1);
+  }
+  lsdb.installLsa(std::make_shared<MidstLsa>(origin, 1, ndn::time::system_clock::now() +
+                                             ndn::time::seconds(3600), mpl));
+  BOOST_REQUIRE_GT(dvMessage.getDvContent(neighbor).size(), ndn::MAX_NDN_PACKET_SIZE);
+
+  auto lsa = fetchTableAsNeighbor();
+  BOOST_REQUIRE(lsa != nullptr);
+  BOOST_CHECK_EQUAL(lsa->getSeqNo(), lsdb.getMidstLsaSeqNo());
+  BOOST_CHECK_GE(lsa->getNpl().size(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(PublishedTableReuse)
+{
+  face.sentData.clear();
+  dvMessage.processInterest(makeInterestName(1), ndn::Interest(makeInterestName(1)));
+  dvMessage.processInterest(makeInterestName(1), ndn::Interest(makeInterestName(1)));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  // Signed only once
+  BOOST_CHECK_EQUAL(face.sentData.front().wireEncode(), face.sentData.back().wireEncode());
+
+  // A changed table is signed again
+  lsdb.installLsa(makeMidstLsa("/ndn/site/%C1.Router/other-router", 1));
+  dvMessage.processInterest(makeInterestName(1), ndn::Interest(makeInterestName(1)));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK_NE(face.sentData.back().getContent(), face.sentData.front().getContent());
+}
+
+BOOST_AUTO_TEST_CASE(MalformedInterest)
+{
+  face.sentData.clear();
+
+  // No requester component
+  ndn::Name name(conf.getRouterPrefix());
+  name.append("nlsr").append("DV").appendNumber(1);
+  BOOST_CHECK_NO_THROW(dvMessage.processInterest(name, ndn::Interest(name)));
+
+  // A requester that is not a Name, and a sequence number that is not a number
+  ndn::Name badRequester = ndn::Name(name).append("not-a-name");
+  BOOST_CHECK_NO_THROW(dvMessage.processInterest(badRequester, ndn::Interest(badRequester)));
+  ndn::Name badSeqNo = ndn::Name(conf.getRouterPrefix()).append("nlsr").append("DV")
+                         .append("not-a-number").append(neighbor.wireEncode());
+  BOOST_CHECK_NO_THROW(dvMessage.processInterest(badSeqNo, ndn::Interest(badSeqNo)));
+
+  BOOST_CHECK_EQUAL(face.sentData.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalRequestName)
+{
+  conf.setIncrementalDv(true);
+  lsdb.installLsa(makeMidstLsa(neighbor, 4));
+
+  // The since is carried inside the requester component, keeping the
+  // segment names in the shape the DV validation rule expects
+  ndn::Name interestName = dvMessage.buildMidstInterestPrefix(neighbor);
+  BOOST_CHECK_EQUAL(interestName.size(), neighbor.size() + 4);
+  ndn::Name requester(interestName.get(-1).blockFromValue());
+  BOOST_CHECK_EQUAL(requester.getPrefix(-1), conf.getRouterPrefix());
+  BOOST_CHECK_EQUAL(requester.get(-1).toSequenceNumber(), 4);
+
+  ndn::Name fullName = dvMessage.buildMidstInterestPrefix(neighbor, true);
+  BOOST_CHECK_EQUAL(ndn::Name(fullName.get(-1).blockFromValue()), conf.getRouterPrefix());
+}
+
+BOOST_AUTO_TEST_CASE(PendingTableRequest)
+{
+  face.sentInterests.clear();
+
+  dvMessage.expressInterest(neighbor, 1);
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 1);
+  BOOST_CHECK(dvMessage.m_neighbors[neighbor].isTableRequestPending);
+
+  // Only one request at a time, the next one goes out when it completes
+  dvMessage.expressInterest(neighbor, 1);
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 1);
+  BOOST_CHECK(dvMessage.m_neighbors[neighbor].isTableRequestNeeded);
+
+  answerTableRequest(getDvInterests().back());
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 2);
+  BOOST_CHECK(dvMessage.m_neighbors[neighbor].isTableRequestPending);
+  BOOST_CHECK(!dvMessage.m_neighbors[neighbor].isTableRequestNeeded);
+
+  answerTableRequest(getDvInterests().back());
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 2);
+  BOOST_CHECK(!dvMessage.m_neighbors[neighbor].isTableRequestPending);
+}
+
+BOOST_AUTO_TEST_CASE(PendingFullTableRequest)
+{
+  conf.setIncrementalDv(true);
+  lsdb.installLsa(makeMidstLsa(neighbor, 4));
+  face.sentInterests.clear();
+
+  dvMessage.expressInterest(neighbor, 1);
+  ndn::Name requester(getDvInterests().back().getName().get(-1).blockFromValue());
+  BOOST_CHECK_EQUAL(requester.getPrefix(-1), conf.getRouterPrefix());
+
+  // A full table asked for while the delta request is in flight stays a full
+  // table request, whatever is asked for after it
+  dvMessage.expressInterest(neighbor, 1, true);
+  dvMessage.expressInterest(neighbor, 1);
+  BOOST_CHECK(dvMessage.m_neighbors[neighbor].isFullTableNeeded);
+
+  // The delta request fails, the follow-up goes out
+  advanceClocks(100_ms, 3_s);
+  requester = ndn::Name(getDvInterests().back().getName().get(-1).blockFromValue());
+  BOOST_CHECK_EQUAL(requester, conf.getRouterPrefix());
+  BOOST_CHECK(!dvMessage.m_neighbors[neighbor].isFullTableNeeded);
+}
+
+BOOST_AUTO_TEST_CASE(LastSentSeqNo)
+{
+  face.sentData.clear();
+  dvMessage.processInterest(makeInterestName(1), ndn::Interest(makeInterestName(1)));
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(dvMessage.m_neighbors[neighbor].lastSentSeqNo, lsdb.getMidstLsaSeqNo());
+  // No table received from the neighbor yet
+  BOOST_CHECK_EQUAL(dvMessage.m_neighbors[neighbor].lastReceivedSeqNo, 0);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateDamping)
+{
+  conf.setDvUpdateMinInterval(1000);
+  conf.setDvUpdateMaxHoldDown(4000);
+  face.sentInterests.clear();
+
+  dvMessage.scheduleUpdate(neighbor);
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 1);
+
+  // Updates within the hold-down are merged into a single one
+  dvMessage.scheduleUpdate(neighbor);
+  dvMessage.scheduleUpdate(neighbor);
+  dvMessage.scheduleUpdate(neighbor);
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 1);
+  BOOST_CHECK_EQUAL(dvMessage.getMergedUpdateCount(), 2);
+
+  advanceClocks(ndn::time::milliseconds(100), 10);
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 2);
+  BOOST_CHECK_EQUAL(dvMessage.m_neighbors[neighbor].holdDown, ndn::time::milliseconds(2000));
+
+  // The hold-down keeps doubling while updates keep coming, up to the maximum
+  dvMessage.scheduleUpdate(neighbor);
+  advanceClocks(ndn::time::milliseconds(100), 20);
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 3);
+  BOOST_CHECK_EQUAL(dvMessage.m_neighbors[neighbor].holdDown, ndn::time::milliseconds(4000));
+
+  // After a quiet period the update goes out right away
+  advanceClocks(ndn::time::milliseconds(1000), 10);
+  dvMessage.scheduleUpdate(neighbor);
+  BOOST_CHECK_EQUAL(getDvInterests().size(), 4);
+  BOOST_CHECK_EQUAL(dvMessage.m_neighbors[neighbor].holdDown, ndn::time::milliseconds(1000));
+}
+
+BOOST_AUTO_TEST_CASE(PureEncoding)
+{
+  ndn::Name routerA("/ndn/site/%C1.Router/router-a");
+  lsdb.installLsa(makeMidstLsa(routerA, 1));
+
+  ndn::Block table = lsdb.wireEncode(neighbor);
+  table.parse();
+  BOOST_REQUIRE_EQUAL(table.elements().size(), 2);
+  MidstPrefixList announced;
+  announced.wireDecode(table.elements()[1]);
+  ndn::Name prefix = ndn::Name(routerA).append("prefix");
+  BOOST_CHECK_EQUAL(announced.getDistance(prefix), 1 + conf.getHopDistance());
+
+  // The installed LSA keeps its own distances
+  BOOST_CHECK_EQUAL(lsdb.findLsa<MidstLsa>(routerA)->getNpl().getDistance(prefix), 1);
+  BOOST_CHECK_EQUAL(lsdb.wireEncode(neighbor), table);
+
+  // Not announced back to its origin
+  table = lsdb.wireEncode(routerA);
+  table.parse();
+  BOOST_CHECK_EQUAL(table.elements().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(DeltaEncoding)
+{
+  ndn::Name routerA("/ndn/site/%C1.Router/router-a");
+  ndn::Name routerB("/ndn/site/%C1.Router/router-b");
+  lsdb.installLsa(makeMidstLsa(routerA, 1));
+  lsdb.installLsa(makeMidstLsa(routerB, 1));
+  uint64_t since = lsdb.getMidstLsaSeqNo();
+
+  // Nothing changed, only our own LSA header is sent
+  ndn::Block content = lsdb.wireEncodeDelta(neighbor, since);
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+  ndn::Block lsdbBlock = content.elements()[0];
+  lsdbBlock.parse();
+  BOOST_CHECK_EQUAL(lsdbBlock.elements().size(), 1);
+
+  lsdb.removeLsa(routerA, Lsa::Type::MIDST);
+  lsdb.installLsa(makeMidstLsa("/ndn/site/%C1.Router/router-c", 1));
+
+  content = lsdb.wireEncodeDelta(neighbor, since);
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+  lsdbBlock = content.elements()[0];
+  lsdbBlock.parse();
+  // header and the prefix list of router-c
+  BOOST_CHECK_EQUAL(lsdbBlock.elements().size(), 2);
+
+  ndn::Block delta = content.elements()[1];
+  delta.parse();
+  BOOST_CHECK_EQUAL(delta.type(), ndn::tlv::nlsr::DvDelta);
+  BOOST_REQUIRE_EQUAL(delta.elements().size(), 2);
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(delta.elements()[0]), since);
+  BOOST_CHECK_EQUAL(ndn::Name(delta.elements()[1]), ndn::Name(routerA).append("prefix"));
+
+  // The change log does not reach back that far
+  content = lsdb.wireEncodeDelta(neighbor, 0);
+  content.parse();
+  BOOST_CHECK_EQUAL(content.elements().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(DeltaMerge)
+{
+  MidstPrefixList mpl;
+  mpl.insert("/x", 10, neighbor, 1);
+  mpl.insert("/y", 10, neighbor, 1);
+  lsdb.installLsa(std::make_shared<MidstLsa>(neighbor, 5, ndn::time::system_clock::now() +
+                                             ndn::time::seconds(3600), mpl));
+
+  MidstPrefixList changes;
+  changes.insert("/z", 20, neighbor, 1);
+  BOOST_CHECK_EQUAL(lsdb.wireDecode(makeDvContent(6, changes, 5, {"/x"})), 6);
+
+  auto lsa = lsdb.findLsa<MidstLsa>(neighbor);
+  BOOST_REQUIRE(lsa != nullptr);
+  BOOST_CHECK_EQUAL(lsa->getSeqNo(), 6);
+  std::list<ndn::Name> names = lsa->getNpl().getNames();
+  std::list<ndn::Name> expected{"/y", "/z"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+
+  // Computed from a table we no longer hold
+  BOOST_CHECK_EQUAL(lsdb.wireDecode(makeDvContent(7, changes, 5, {})), 0);
+  BOOST_CHECK_EQUAL(lsdb.findLsa<MidstLsa>(neighbor)->getSeqNo(), 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
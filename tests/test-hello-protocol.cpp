@@ -23,6 +23,8 @@
 #include "nlsr.hpp"
 #include "test-common.hpp"
 
+#include <ndn-cxx/security/signing-helpers.hpp>
+
 namespace nlsr {
 namespace test {
 
@@ -47,7 +49,9 @@ public:
   {
     int sent = 0;
     for (const auto& i : face.sentInterests) {
-      if (name == i.getName().getPrefix(4)) {
+      // probes share the neighbor prefix
+      if (name == i.getName().getPrefix(4) &&
+          i.getName().get(-2).toUri() == nlsr::HelloProtocol::INFO_COMPONENT) {
         sent++;
       }
     }
@@ -85,6 +89,23 @@ public:
                       Adjacent::STATUS_INACTIVE);
   }
 
+  /*! \brief Answers the probes sent since the last call, as the neighbor would.
+   */
+  void
+  answerProbes()
+  {
+    for (; nAnsweredInterests < face.sentInterests.size(); ++nAnsweredInterests) {
+      const auto& interest = face.sentInterests[nAnsweredInterests];
+      if (interest.getName().size() < 3 ||
+          interest.getName().get(-3).toUri() != nlsr::HelloProtocol::PROBE_COMPONENT) {
+        continue;
+      }
+      ndn::Data data(interest.getName());
+      m_keyChain.sign(data, ndn::security::signingWithSha256());
+      face.receive(data);
+    }
+  }
+
 public:
   ndn::util::DummyClientFace face;
   ConfParameter conf;
@@ -93,6 +114,7 @@ public:
   Nlsr nlsr;
   HelloProtocol& helloProtocol;
   const std::string ACTIVE_NEIGHBOR = "/ndn/site/%C1.Router/router-active";
+  size_t nAnsweredInterests = 0;
 };
 
 BOOST_FIXTURE_TEST_SUITE(HelloProtocol, HelloProtocolFixture)
@@ -101,6 +123,8 @@ BOOST_AUTO_TEST_CASE(Basic)
 {
   this->advanceClocks(10_s);
   checkPrefixRegistered(face, "/ndn/site/%C1.Router/this-router/nlsr/INFO");
+  // Probes are answered even though probe-interval is 0 by default
+  checkPrefixRegistered(face, "/ndn/site/%C1.Router/this-router/nlsr/PROBE");
   face.sentInterests.clear();
 }
 
@@ -147,6 +171,263 @@ BOOST_AUTO_TEST_CASE(CheckHelloDataValidatedSignal) // # 5157
   BOOST_CHECK_EQUAL(adjList.getStatusOfNeighbor(adj1.getName()), Adjacent::STATUS_ACTIVE);
 }
 
+BOOST_AUTO_TEST_CASE(CachedHelloData)
+{
+  // interest name: /<router>/nlsr/INFO/<neighbor>
+  ndn::Name interestName(conf.getRouterPrefix());
+  interestName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  interestName.append(nlsr::HelloProtocol::INFO_COMPONENT);
+  interestName.append(ndn::Name(ACTIVE_NEIGHBOR).wireEncode());
+  ndn::Interest interest(interestName);
+
+  face.sentData.clear();
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+
+  // The second hello is answered with the same signed Data
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK(face.sentData[0].wireEncode() == face.sentData[1].wireEncode());
+
+  this->advanceClocks(1_s, helloProtocol.getHelloDataVersionWindow());
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+
+  // Once the version window has passed, a new version is signed
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK_NE(face.sentData[1].getName(), face.sentData[2].getName());
+  BOOST_CHECK_EQUAL(face.sentData[2].getName().getPrefix(-1), interestName);
+}
+
+BOOST_AUTO_TEST_CASE(CachedHelloDataDefaultInterval)
+{
+  BOOST_REQUIRE_EQUAL(conf.getInfoInterestInterval(), HELLO_INTERVAL_DEFAULT);
+
+  // interest name: /<router>/nlsr/INFO/<neighbor>
+  ndn::Name interestName(conf.getRouterPrefix());
+  interestName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  interestName.append(nlsr::HelloProtocol::INFO_COMPONENT);
+  interestName.append(ndn::Name(ACTIVE_NEIGHBOR).wireEncode());
+  ndn::Interest interest(interestName);
+
+  // Hellos arriving one default interval apart are answered from the cache
+  face.sentData.clear();
+  for (int i = 0; i < 3; ++i) {
+    helloProtocol.processInterest(interestName, interest);
+    this->advanceClocks(1_s, ndn::time::seconds(HELLO_INTERVAL_DEFAULT));
+  }
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK(face.sentData[0].wireEncode() == face.sentData[1].wireEncode());
+  BOOST_CHECK(face.sentData[1].wireEncode() == face.sentData[2].wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(CachedHelloDataKeyRollover)
+{
+  auto identity = addIdentity(conf.getRouterPrefix());
+  m_keyChain.setDefaultIdentity(identity);
+
+  // interest name: /<router>/nlsr/INFO/<neighbor>
+  ndn::Name interestName(conf.getRouterPrefix());
+  interestName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  interestName.append(nlsr::HelloProtocol::INFO_COMPONENT);
+  interestName.append(ndn::Name(ACTIVE_NEIGHBOR).wireEncode());
+  ndn::Interest interest(interestName);
+
+  face.sentData.clear();
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+
+  // The identity stays the same, but its default key is rolled over
+  auto key = m_keyChain.createKey(identity);
+  m_keyChain.setDefaultKey(identity, key);
+
+  // Cache hits do not look at the PIB, the old key stays in use for now
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK(face.sentData[0].wireEncode() == face.sentData[1].wireEncode());
+
+  // The next version is signed with the new key
+  this->advanceClocks(1_s, helloProtocol.getHelloDataVersionWindow());
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK_NE(face.sentData[1].getName(), face.sentData[2].getName());
+  BOOST_REQUIRE(face.sentData[2].getKeyLocator());
+  BOOST_CHECK_EQUAL(face.sentData[2].getKeyLocator()->getName(),
+                    key.getDefaultCertificate().getName());
+}
+
+BOOST_AUTO_TEST_CASE(CachedHelloDataNewSigningInfo)
+{
+  // interest name: /<router>/nlsr/INFO/<neighbor>
+  ndn::Name interestName(conf.getRouterPrefix());
+  interestName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  interestName.append(nlsr::HelloProtocol::INFO_COMPONENT);
+  interestName.append(ndn::Name(ACTIVE_NEIGHBOR).wireEncode());
+  ndn::Interest interest(interestName);
+
+  face.sentData.clear();
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+
+  // initializeKey() replaces the SigningInfo with the NLSR instance identity
+  auto certificate = conf.initializeKey();
+  BOOST_REQUIRE(certificate != nullptr);
+
+  helloProtocol.processInterest(interestName, interest);
+  this->advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_NE(face.sentData[0].getName(), face.sentData[1].getName());
+  BOOST_REQUIRE(face.sentData[1].getKeyLocator());
+  BOOST_CHECK(certificate->getKeyName().isPrefixOf(face.sentData[1].getKeyLocator()->getName()));
+}
+
+BOOST_AUTO_TEST_CASE(AnswerProbe)
+{
+  // interest name: /<router>/nlsr/PROBE/<neighbor>/<seq>
+  ndn::Name interestName(conf.getRouterPrefix());
+  interestName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  interestName.append(nlsr::HelloProtocol::PROBE_COMPONENT);
+  interestName.append(ndn::Name(ACTIVE_NEIGHBOR).wireEncode());
+  interestName.appendNumber(1);
+
+  face.sentData.clear();
+  helloProtocol.processProbeInterest(interestName, ndn::Interest(interestName));
+  this->advanceClocks(10_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentData[0].getName(), interestName);
+  BOOST_CHECK_EQUAL(face.sentData[0].getSignatureInfo().getSignatureType(),
+                    ndn::tlv::DigestSha256);
+
+  // Probes from routers that are not neighbors are ignored
+  ndn::Name otherName(conf.getRouterPrefix());
+  otherName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  otherName.append(nlsr::HelloProtocol::PROBE_COMPONENT);
+  otherName.append(ndn::Name("/ndn/site/%C1.Router/stranger").wireEncode());
+  otherName.appendNumber(1);
+  helloProtocol.processProbeInterest(otherName, ndn::Interest(otherName));
+  this->advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ProbeFailureDetection)
+{
+  conf.setProbeInterval(100);
+  conf.setProbeDetectMultiplier(3);
+
+  // data name: /<neighbor>/nlsr/INFO/<router>/<version>
+  ndn::Name dataName(ACTIVE_NEIGHBOR);
+  dataName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  dataName.append(nlsr::HelloProtocol::INFO_COMPONENT);
+  dataName.append(conf.getRouterPrefix().wireEncode());
+  helloProtocol.onContentValidated(ndn::Data(ndn::Name(dataName).appendVersion()));
+
+  // As long as the probes are answered, the neighbor stays ACTIVE
+  for (int i = 0; i < 20; ++i) {
+    this->advanceClocks(10_ms, 100_ms);
+    answerProbes();
+  }
+  BOOST_CHECK_EQUAL(adjList.getStatusOfNeighbor(ACTIVE_NEIGHBOR), Adjacent::STATUS_ACTIVE);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_isBuildAdjLsaScheduled, false);
+
+  // Three unanswered intervals take it down, without waiting for hello retries
+  this->advanceClocks(10_ms, 400_ms);
+  BOOST_CHECK_EQUAL(adjList.getStatusOfNeighbor(ACTIVE_NEIGHBOR), Adjacent::STATUS_INACTIVE);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_isBuildAdjLsaScheduled, true);
+
+  // No more probes are sent to an INACTIVE neighbor
+  size_t nSentInterests = face.sentInterests.size();
+  this->advanceClocks(10_ms, 1_s);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), nSentInterests);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptiveHelloInterval)
+{
+  conf.setHelloIntervalMax(240);
+  auto adjacent = adjList.findAdjacent(ndn::Name(ACTIVE_NEIGHBOR));
+
+  helloProtocol.sendHelloInterest(ndn::Name(ACTIVE_NEIGHBOR));
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 60_s);
+
+  // data name: /<neighbor>/nlsr/INFO/<router>/<version>
+  ndn::Name dataName(ACTIVE_NEIGHBOR);
+  dataName.append(nlsr::HelloProtocol::NLSR_COMPONENT);
+  dataName.append(nlsr::HelloProtocol::INFO_COMPONENT);
+  dataName.append(conf.getRouterPrefix().wireEncode());
+
+  // Without probes, hellos are the only failure detection: the interval stays fixed
+  helloProtocol.onContentValidated(ndn::Data(ndn::Name(dataName).appendVersion()));
+  helloProtocol.onContentValidated(ndn::Data(ndn::Name(dataName).appendVersion()));
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 60_s);
+
+  // Once probing has started, every hello answered on the first try doubles the
+  // interval, up to the maximum
+  conf.setProbeInterval(1000);
+  conf.setProbeDetectMultiplier(3);
+  helloProtocol.onContentValidated(ndn::Data(ndn::Name(dataName).appendVersion()));
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 60_s);
+  helloProtocol.onContentValidated(ndn::Data(ndn::Name(dataName).appendVersion()));
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 120_s);
+  helloProtocol.onContentValidated(ndn::Data(ndn::Name(dataName).appendVersion()));
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 240_s);
+  helloProtocol.onContentValidated(ndn::Data(ndn::Name(dataName).appendVersion()));
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 240_s);
+
+  // The probes go unanswered: the neighbor is INACTIVE and the interval snaps back
+  // to hello-interval
+  this->advanceClocks(10_ms, 3500_ms);
+  BOOST_CHECK_EQUAL(adjacent->getStatus(), Adjacent::STATUS_INACTIVE);
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 60_s);
+
+  // and the next periodic hello is not left 240 seconds away
+  int nSentHellos = checkHelloInterests(ACTIVE_NEIGHBOR);
+  this->advanceClocks(1_s, 60_s);
+  BOOST_CHECK_EQUAL(checkHelloInterests(ACTIVE_NEIGHBOR), nSentHellos + 1);
+}
+
+BOOST_AUTO_TEST_CASE(HelloIntervalResetOnTimeout)
+{
+  conf.setHelloIntervalMax(240);
+  auto adjacent = adjList.findAdjacent(ndn::Name(ACTIVE_NEIGHBOR));
+  helloProtocol.sendHelloInterest(ndn::Name(ACTIVE_NEIGHBOR));
+  adjacent->setHelloInterval(240_s);
+
+  // The first hello times out: the interval snaps back to hello-interval
+  this->advanceClocks(10_ms, 4_s);
+  BOOST_CHECK_EQUAL(adjacent->getHelloInterval(), 60_s);
+}
+
+BOOST_AUTO_TEST_CASE(RttLinkCost)
+{
+  conf.setRttLinkCost(true);
+  conf.setRttCostQuantum(5);
+  conf.setRttCostHysteresis(20);
+  auto adjacent = adjList.findAdjacent(ndn::Name(ACTIVE_NEIGHBOR));
+  BOOST_CHECK_EQUAL(adjacent->getLinkCost(), 10);
+
+  // The first sample replaces the configured cost: 100 ms / 5 ms
+  helloProtocol.updateLinkCost(ACTIVE_NEIGHBOR, 100_ms);
+  BOOST_CHECK_EQUAL(adjacent->getSmoothedRtt(), 100_ms);
+  BOOST_CHECK_EQUAL(adjacent->getLinkCost(), 20);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_isBuildAdjLsaScheduled, true);
+
+  // A small change stays within the hysteresis
+  helloProtocol.updateLinkCost(ACTIVE_NEIGHBOR, 108_ms);
+  BOOST_CHECK_EQUAL(adjacent->getSmoothedRtt(), 101_ms);
+  BOOST_CHECK_EQUAL(adjacent->getLinkCost(), 20);
+
+  // A lasting change goes through
+  for (int i = 0; i < 20; ++i) {
+    helloProtocol.updateLinkCost(ACTIVE_NEIGHBOR, 200_ms);
+  }
+  BOOST_CHECK_GT(adjacent->getLinkCost(), 24);
+  BOOST_CHECK_LE(adjacent->getLinkCost(), 40);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
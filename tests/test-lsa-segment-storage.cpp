@@ -138,6 +138,48 @@ BOOST_AUTO_TEST_CASE(Basic)
   // Scheduled removal of LSA
   advanceClocks(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT));
   BOOST_CHECK_EQUAL(lsdb.m_lsaStorage.size(), 0);
+  BOOST_CHECK_EQUAL(lsdb.m_lsaStorage.getUsedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LruEviction)
+{
+  auto makeSegment = [] (const ndn::Name& name) {
+    auto data = std::make_shared<ndn::Data>(name);
+    data->setContent(std::vector<uint8_t>(100, 0xAA).data(), 100);
+    return signData(data);
+  };
+
+  ndn::Name prefix("/localhop/ndn/nlsr/LSA/other-site/%C1.Router/other-router/NAME");
+  auto seg0 = makeSegment(ndn::Name(prefix).appendNumber(12).appendVersion(1).appendSegment(0));
+  auto seg1 = makeSegment(ndn::Name(prefix).appendNumber(12).appendVersion(1).appendSegment(1));
+  auto seg2 = makeSegment(ndn::Name(prefix).appendNumber(12).appendVersion(1).appendSegment(2));
+
+  // Room for two segments only
+  LsaSegmentStorage storage(m_scheduler, seg0->wireEncode().size() * 2 + 10, ndn::time::seconds(10));
+  storage.insert(*seg0);
+  storage.insert(*seg1);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+
+  // Discovery Interest finds the first segment and makes it the most recently used
+  ndn::Interest discovery(ndn::Name(prefix).appendNumber(12));
+  discovery.setCanBePrefix(true);
+  auto found = storage.find(discovery);
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), seg0->getName());
+  BOOST_CHECK_EQUAL(storage.getHitCount(), 1);
+
+  // seg1 is now the least recently used
+  storage.insert(*seg2);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK_EQUAL(storage.getEvictionCount(), 1);
+  BOOST_CHECK(storage.find(ndn::Interest(seg1->getName())) == nullptr);
+  BOOST_CHECK(storage.find(ndn::Interest(seg2->getName())) != nullptr);
+  BOOST_CHECK_EQUAL(storage.getMissCount(), 1);
+  BOOST_CHECK_EQUAL(storage.getHitCount(), 2);
+
+  advanceClocks(ndn::time::seconds(10));
+  BOOST_CHECK_EQUAL(storage.size(), 0);
+  BOOST_CHECK_EQUAL(storage.getExpirationCount(), 2);
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestLsaSegmentStorage
@@ -28,6 +28,8 @@
 
 #include <ndn-cxx/util/time.hpp>
 
+#include <boost/lexical_cast.hpp>
+
 namespace nlsr {
 namespace test {
 
@@ -410,6 +412,20 @@ BOOST_AUTO_TEST_CASE(OperatorEquals)
   BOOST_CHECK(lsa1.isEqualContent(lsa2));
 }
 
+BOOST_AUTO_TEST_CASE(TypeFromNameComponent)
+{
+  for (auto type : {Lsa::Type::ADJACENCY, Lsa::Type::COORDINATE,
+                    Lsa::Type::NAME, Lsa::Type::MIDST}) {
+    ndn::name::Component component(boost::lexical_cast<std::string>(type));
+    BOOST_CHECK_EQUAL(getLsaTypeFromNameComponent(component), type);
+  }
+
+  BOOST_CHECK_EQUAL(getLsaTypeFromNameComponent(ndn::name::Component("name")), Lsa::Type::BASE);
+  BOOST_CHECK_EQUAL(getLsaTypeFromNameComponent(ndn::name::Component("NAMES")), Lsa::Type::BASE);
+  BOOST_CHECK_EQUAL(getLsaTypeFromNameComponent(ndn::name::Component::fromNumber(3)),
+                    Lsa::Type::BASE);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsdb-snapshot.hpp"
+#include "lsdb.hpp"
+
+#include "test-common.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace nlsr {
+namespace test {
+
+class LsdbSnapshotFixture : public UnitTestTimeFixture
+{
+public:
+  LsdbSnapshotFixture()
+    : face(m_ioService, m_keyChain, {true, true})
+    , conf(face, m_keyChain)
+    , confProcessor(conf)
+    , stateDir(boost::filesystem::temp_directory_path() /
+               boost::filesystem::unique_path("nlsr-lsdb-snapshot-%%%%%%%%"))
+    , otherRouter("/ndn/site/%C1.Router/other-router")
+  {
+    boost::filesystem::create_directories(stateDir);
+    conf.setStateFileDir(stateDir.string());
+    conf.setLsdbSnapshotInterval(60);
+    addIdentity("/ndn/site/%C1.Router/this-router");
+  }
+
+  ~LsdbSnapshotFixture()
+  {
+    boost::filesystem::remove_all(stateDir);
+  }
+
+  std::shared_ptr<NameLsa>
+  makeNameLsa(const ndn::Name& originRouter, uint64_t seqNo, ndn::time::seconds lifetime)
+  {
+    NamePrefixList npl{ndn::Name(originRouter).append("prefix")};
+    return std::make_shared<NameLsa>(originRouter, seqNo,
+                                     ndn::time::system_clock::now() + lifetime, npl);
+  }
+
+  void
+  writeSnapshot(const std::vector<std::shared_ptr<Lsa>>& lsas)
+  {
+    BOOST_REQUIRE(LsdbSnapshot(stateDir.string()).write(lsas));
+  }
+
+public:
+  ndn::util::DummyClientFace face;
+  ConfParameter conf;
+  DummyConfFileProcessor confProcessor;
+  boost::filesystem::path stateDir;
+  ndn::Name otherRouter;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLsdbSnapshot, LsdbSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(WriteAndRead)
+{
+  LsdbSnapshot snapshot(stateDir.string());
+  BOOST_CHECK(snapshot.read().empty());
+
+  auto nameLsa = makeNameLsa(otherRouter, 10, ndn::time::seconds(3600));
+  AdjacencyList adjList;
+  adjList.insert(Adjacent("/ndn/site/%C1.Router/this-router", ndn::FaceUri("udp4://10.0.0.1"),
+                          10, Adjacent::STATUS_ACTIVE, 0, 0));
+  auto adjLsa = std::make_shared<AdjLsa>(otherRouter, 5,
+                                         ndn::time::system_clock::now() + ndn::time::seconds(3600),
+                                         1, adjList);
+  BOOST_REQUIRE(snapshot.write({nameLsa, adjLsa}));
+
+  auto lsas = snapshot.read();
+  BOOST_REQUIRE_EQUAL(lsas.size(), 2);
+  BOOST_CHECK_EQUAL(lsas[0]->getType(), Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(lsas[0]->getSeqNo(), 10);
+  BOOST_CHECK_EQUAL(lsas[0]->getOriginRouter(), otherRouter);
+  BOOST_CHECK_EQUAL(lsas[1]->getType(), Lsa::Type::ADJACENCY);
+  BOOST_CHECK_EQUAL(lsas[1]->getSeqNo(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  LsdbSnapshot snapshot(stateDir.string());
+  BOOST_REQUIRE(snapshot.write({makeNameLsa(otherRouter, 1, ndn::time::seconds(3600)),
+                                makeNameLsa("/ndn/site/%C1.Router/router3", 1,
+                                            ndn::time::seconds(3600))}));
+
+  auto fileSize = boost::filesystem::file_size(snapshot.getFilePath());
+  boost::filesystem::resize_file(snapshot.getFilePath(), fileSize - 2);
+
+  // The first LSA is still intact
+  BOOST_CHECK_EQUAL(snapshot.read().size(), 1);
+
+  std::ofstream(snapshot.getFilePath(), std::ios::trunc) << "garbage";
+  BOOST_CHECK(snapshot.read().empty());
+}
+
+BOOST_AUTO_TEST_CASE(ProvisionalInstall)
+{
+  writeSnapshot({makeNameLsa(otherRouter, 10, ndn::time::seconds(3600)),
+                 makeNameLsa("/ndn/site/%C1.Router/router3", 4, ndn::time::seconds(3600)),
+                 makeNameLsa("/ndn/site/%C1.Router/expired", 7, ndn::time::seconds(-1)),
+                 makeNameLsa(conf.getRouterPrefix(), 1000, ndn::time::seconds(3600))});
+
+  Lsdb lsdb(face, m_keyChain, conf);
+  BOOST_CHECK_EQUAL(lsdb.loadSnapshot(), 2);
+
+  BOOST_CHECK(lsdb.findLsa(otherRouter, Lsa::Type::NAME) != nullptr);
+  BOOST_CHECK(lsdb.findLsa("/ndn/site/%C1.Router/expired", Lsa::Type::NAME) == nullptr);
+  // Our own LSA is never taken from the snapshot
+  BOOST_CHECK_NE(lsdb.findLsa(conf.getRouterPrefix(), Lsa::Type::NAME)->getSeqNo(), 1000);
+
+  // An older sequence number is not new, the same one confirms the LSA
+  BOOST_CHECK(!lsdb.isLsaNew(otherRouter, Lsa::Type::NAME, 9));
+  lsdb.confirmProvisionalLsa(otherRouter, Lsa::Type::NAME, 10);
+
+  this->advanceClocks(ndn::time::seconds(1),
+                      Lsdb::SNAPSHOT_CONFIRMATION_TIMEOUT + ndn::time::seconds(1));
+
+  BOOST_CHECK(lsdb.findLsa(otherRouter, Lsa::Type::NAME) != nullptr);
+  BOOST_CHECK(lsdb.findLsa("/ndn/site/%C1.Router/router3", Lsa::Type::NAME) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(OriginRestarted)
+{
+  writeSnapshot({makeNameLsa(otherRouter, 10, ndn::time::seconds(3600))});
+
+  Lsdb lsdb(face, m_keyChain, conf);
+  BOOST_CHECK_EQUAL(lsdb.loadSnapshot(), 1);
+  BOOST_CHECK(!lsdb.isLsaNew(otherRouter, Lsa::Type::NAME, 3));
+
+  // The origin came back with lower sequence numbers; its current LSA is
+  // fetched instead of waiting for the snapshot copy to time out
+  lsdb.confirmProvisionalLsa(otherRouter, Lsa::Type::NAME, 3);
+  BOOST_CHECK(lsdb.findLsa(otherRouter, Lsa::Type::NAME) == nullptr);
+  BOOST_CHECK(lsdb.isLsaNew(otherRouter, Lsa::Type::NAME, 3));
+  BOOST_CHECK(lsdb.m_provisionalLsas.empty());
+}
+
+BOOST_AUTO_TEST_CASE(PeriodicWrite)
+{
+  Lsdb lsdb(face, m_keyChain, conf);
+  lsdb.installLsa(makeNameLsa(otherRouter, 3, ndn::time::seconds(3600)));
+
+  this->advanceClocks(ndn::time::seconds(1), ndn::time::seconds(61));
+
+  auto lsas = LsdbSnapshot(stateDir.string()).read();
+  BOOST_REQUIRE_EQUAL(lsas.size(), 1);
+  BOOST_CHECK_EQUAL(lsas[0]->getOriginRouter(), otherRouter);
+  BOOST_CHECK_EQUAL(lsas[0]->getSeqNo(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
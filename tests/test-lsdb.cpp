@@ -317,6 +317,29 @@ BOOST_AUTO_TEST_CASE(ReceiveSegmentedLsaData)
   BOOST_CHECK_EQUAL(foundLsa->wireEncode(), lsa.wireEncode());
 }
 
+BOOST_AUTO_TEST_CASE(SeqNoTrackingCleanup)
+{
+  ndn::Name router("/ndn/cs/%C1.Router/router1");
+  NameLsa lsa(router, 12, ndn::time::system_clock::now() + ndn::time::seconds(3600),
+              NamePrefixList());
+
+  ndn::Name interestName("/localhop/ndn/nlsr/LSA/cs/%C1.Router/router1/NAME/");
+  BOOST_CHECK_EQUAL(lsdb.makeLsaName(router, Lsa::Type::NAME), interestName);
+  interestName.appendNumber(12);
+
+  ndn::Block block = lsa.wireEncode();
+  lsdb.afterFetchLsa(block.getBuffer(), interestName);
+  BOOST_REQUIRE(lsdb.doesLsaExist(router, Lsa::Type::NAME));
+  BOOST_CHECK_EQUAL(lsdb.getTrackedSeqNoCount(), 1);
+
+  // An older sequence number does not replace the tracked one
+  BOOST_CHECK(!lsdb.updateHighestSeqNo(lsdb.makeLsaName(router, Lsa::Type::NAME), 11));
+  BOOST_CHECK_EQUAL(lsdb.getTrackedSeqNoCount(), 1);
+
+  lsdb.removeLsa(router, Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(lsdb.getTrackedSeqNoCount(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(LsdbRemoveAndExists)
 {
   ndn::time::system_clock::TimePoint testTimePoint =  ndn::time::system_clock::now();
@@ -498,6 +521,45 @@ BOOST_AUTO_TEST_CASE(LsdbSignals)
   checkSignalResult(LsdbUpdate::REMOVED, lsaPtr, {}, {});
 }
 
+BOOST_AUTO_TEST_CASE(AdjLsaBuildThrottle)
+{
+  ndn::time::milliseconds holdTime = 0_ms;
+  ndn::util::signal::ScopedConnection conn = lsdb.adjLsaBuildHoldTimeSignal.connect(
+    [&] (ndn::time::milliseconds currentHoldTime) { holdTime = currentHoldTime; });
+
+  // An isolated request waits for the initial delay only
+  lsdb.scheduleAdjLsaBuild();
+  BOOST_CHECK(lsdb.getIsBuildAdjLsaScheduled());
+  BOOST_CHECK_EQUAL(holdTime, 10_s);
+  advanceClocks(1_s, 2);
+  BOOST_CHECK(!lsdb.getIsBuildAdjLsaScheduled());
+
+  // A request right after that build waits for the Adjacency LSA build interval
+  lsdb.scheduleAdjLsaBuild();
+  BOOST_CHECK_EQUAL(holdTime, 20_s);
+  advanceClocks(1_s, 8);
+  BOOST_CHECK(lsdb.getIsBuildAdjLsaScheduled());
+  advanceClocks(1_s);
+  BOOST_CHECK(!lsdb.getIsBuildAdjLsaScheduled());
+
+  // The next one waits twice as long, and requests while it is pending are merged into it
+  lsdb.scheduleAdjLsaBuild();
+  BOOST_CHECK_EQUAL(holdTime, 40_s);
+  advanceClocks(1_s, 5);
+  lsdb.scheduleAdjLsaBuild();
+  advanceClocks(1_s, 14);
+  BOOST_CHECK(lsdb.getIsBuildAdjLsaScheduled());
+  advanceClocks(1_s);
+  BOOST_CHECK(!lsdb.getIsBuildAdjLsaScheduled());
+
+  // After a quiet period, builds are back to the initial delay
+  advanceClocks(10_s, 8);
+  lsdb.scheduleAdjLsaBuild();
+  BOOST_CHECK_EQUAL(holdTime, 10_s);
+  advanceClocks(1_s);
+  BOOST_CHECK(!lsdb.getIsBuildAdjLsaScheduled());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLsdb
 
 } // namespace test
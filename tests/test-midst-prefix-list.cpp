@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2019-2021,  Universidad Autonoma de San Luis Potosi,
+ *                           Facultad de Ingeniería.
+ *
+ * This file is part of a modified version of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midst-prefix-list.hpp"
+#include "tests/boost-test.hpp"
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestMidstPrefixList)
+
+/*
+  Inserting a known name replaces its data, and lookups go through the
+  name index.
+ */
+BOOST_AUTO_TEST_CASE(InsertAndLookup)
+{
+  MidstPrefixList mpl;
+  BOOST_CHECK(mpl.insert("/a", 10, "/router/a", 1));
+  BOOST_CHECK(mpl.insert("/b", 20, "/router/b", 2));
+  BOOST_CHECK(mpl.insert("/a", 15, "/router/c", 3));
+
+  BOOST_CHECK_EQUAL(mpl.size(), 2);
+  BOOST_CHECK_EQUAL(mpl.getDistance("/a"), 15);
+  BOOST_CHECK_EQUAL(mpl.getAnchor("/a"), ndn::Name("/router/c"));
+  BOOST_CHECK_EQUAL(mpl.getSeqNo("/a"), 3);
+  BOOST_CHECK_EQUAL(mpl.find("/b"), 1);
+  BOOST_CHECK_EQUAL(mpl.find("/c"), mpl.size());
+  BOOST_CHECK_EQUAL(mpl.getDistance("/c"), -1);
+}
+
+/*
+  Removing a name moves the last entry into its place, the index follows
+  and sort() restores the name order.
+ */
+BOOST_AUTO_TEST_CASE(RemoveAndSort)
+{
+  MidstPrefixList mpl;
+  mpl.insert("/a", 1, "/router/a", 1);
+  mpl.insert("/b", 2, "/router/b", 1);
+  mpl.insert("/c", 3, "/router/c", 1);
+
+  BOOST_CHECK(mpl.remove("/a"));
+  BOOST_CHECK(!mpl.remove("/a"));
+  BOOST_CHECK_EQUAL(mpl.size(), 2);
+  BOOST_CHECK_EQUAL(mpl.at(0).name, ndn::Name("/c"));
+  BOOST_CHECK_EQUAL(mpl.getDistance("/c"), 3);
+
+  mpl.insert("/a", 4, "/router/a", 1);
+  mpl.sort();
+  std::list<ndn::Name> names = mpl.getNames();
+  std::list<ndn::Name> expected{"/a", "/b", "/c"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(mpl.getDistance("/a"), 4);
+  BOOST_CHECK_EQUAL(mpl.find("/c"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Iteration)
+{
+  MidstPrefixList mpl;
+  mpl.insert("/a", 1, "/router/a", 5);
+  mpl.insert("/b", 2, "/router/b", 6);
+
+  double totalDistance = 0;
+  size_t nEntries = 0;
+  for (const auto& entry : mpl) {
+    BOOST_CHECK_EQUAL(entry.anchor, mpl.getAnchor(entry.name));
+    BOOST_CHECK_EQUAL(entry.seqNo, mpl.getSeqNo(entry.name));
+    totalDistance += entry.distance;
+    ++nEntries;
+  }
+  BOOST_CHECK_EQUAL(nEntries, 2);
+  BOOST_CHECK_EQUAL(totalDistance, 3);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeAndDecode)
+{
+  MidstPrefixList mpl;
+  mpl.insert("/a", 1, "/router/a", 5);
+  mpl.insert("/b", 2, "/router/b", 6);
+
+  MidstPrefixList decoded;
+  decoded.wireDecode(mpl.wireEncode(10));
+  BOOST_CHECK_EQUAL(decoded.size(), 2);
+  BOOST_CHECK_EQUAL(decoded.getDistance("/a"), 11);
+  BOOST_CHECK_EQUAL(decoded.getDistance("/b"), 12);
+  BOOST_CHECK_EQUAL(decoded.getAnchor("/b"), ndn::Name("/router/b"));
+  BOOST_CHECK_EQUAL(decoded.getSeqNo("/b"), 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -118,7 +118,9 @@ BOOST_AUTO_TEST_CASE(SetEventIntervals)
 {
   // Simulate loading configuration file
   conf.setAdjLsaBuildInterval(3);
+  conf.setAdjLsaBuildInitialDelay(500);
   conf.setRoutingCalcInterval(9);
+  conf.setRoutingCalcInitialDelay(200);
 
   Nlsr nlsr2(m_face, m_keyChain, conf);
 
@@ -126,7 +128,9 @@ BOOST_AUTO_TEST_CASE(SetEventIntervals)
   const RoutingTable& rt = nlsr2.m_routingTable;
 
   BOOST_CHECK_EQUAL(lsdb.m_adjLsaBuildInterval, 3_s);
+  BOOST_CHECK_EQUAL(lsdb.m_adjLsaBuildThrottle.getInitialDelay(), 500_ms);
   BOOST_CHECK_EQUAL(rt.m_routingCalcInterval, 9_s);
+  BOOST_CHECK_EQUAL(rt.m_routingCalcThrottle.getInitialDelay(), 200_ms);
 }
 
 BOOST_AUTO_TEST_CASE(FaceCreateEvent)
@@ -396,7 +400,8 @@ BOOST_AUTO_TEST_CASE(BuildAdjLsaAfterHelloResponse)
   // Receive HELLO response from Router A and B
   receiveHelloData(neighborAName, conf.getRouterPrefix());
   receiveHelloData(neighborBName, conf.getRouterPrefix());
-  this->advanceClocks(1_s, 10);
+  // This is the third build in a row, so it is held back twice as long
+  this->advanceClocks(1_s, 20);
 
   // Adjacency LSA should be built
   lsa = lsdb.findLsa<AdjLsa>(conf.getRouterPrefix());
@@ -470,6 +475,93 @@ BOOST_AUTO_TEST_CASE(FaceDatasetProcess)
   BOOST_CHECK_EQUAL(adjList.getAdjacent("/ndn/neighborB").getFaceId(), payload2.getFaceId());
 }
 
+BOOST_AUTO_TEST_CASE(FaceDatasetProcessBatch)
+{
+  neighbors.insert(Adjacent("/ndn/neighborA", ndn::FaceUri("udp4://192.168.0.100:6363"),
+                            25, Adjacent::STATUS_INACTIVE, 0, 0));
+  // Already configured, must be left alone
+  neighbors.insert(Adjacent("/ndn/neighborB", ndn::FaceUri("udp4://192.168.0.101:6363"),
+                            10, Adjacent::STATUS_INACTIVE, 0, 7));
+  neighbors.insert(Adjacent("/ndn/neighborC", ndn::FaceUri("udp4://192.168.0.102:6363"),
+                            10, Adjacent::STATUS_INACTIVE, 0, 0));
+
+  std::vector<ndn::nfd::FaceStatus> faceStatuses;
+  for (uint64_t faceId = 100; faceId < 1100; ++faceId) {
+    ndn::nfd::FaceStatus unrelated;
+    unrelated.setFaceId(faceId)
+      .setRemoteUri("udp4://10.0." + std::to_string(faceId / 256) + "." +
+                    std::to_string(faceId % 256) + ":6363");
+    faceStatuses.push_back(unrelated);
+  }
+  ndn::nfd::FaceStatus faceA;
+  faceA.setFaceId(1).setRemoteUri("udp4://192.168.0.100:6363");
+  ndn::nfd::FaceStatus duplicateA;
+  duplicateA.setFaceId(3).setRemoteUri("udp4://192.168.0.100:6363");
+  ndn::nfd::FaceStatus faceB;
+  faceB.setFaceId(4).setRemoteUri("udp4://192.168.0.101:6363");
+  ndn::nfd::FaceStatus faceC;
+  faceC.setFaceId(2).setRemoteUri("udp4://192.168.0.102:6363");
+  faceStatuses.insert(faceStatuses.begin() + 500, {faceA, duplicateA, faceB, faceC});
+
+  m_face.sentInterests.clear();
+  nlsr.processFaceDataset(faceStatuses);
+  this->advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(neighbors.getAdjacent("/ndn/neighborA").getFaceId(), 1);
+  BOOST_CHECK_EQUAL(neighbors.getAdjacent("/ndn/neighborB").getFaceId(), 7);
+  BOOST_CHECK_EQUAL(neighbors.getAdjacent("/ndn/neighborC").getFaceId(), 2);
+
+  // The neighbor prefixes are registered first, then the LSA prefix
+  std::vector<ndn::Name> registered;
+  for (const auto& interest : m_face.sentInterests) {
+    if (ndn::Name("/localhost/nfd/rib/register").isPrefixOf(interest.getName())) {
+      ndn::nfd::ControlParameters params(interest.getName().get(4).blockFromValue());
+      registered.push_back(params.getName());
+    }
+  }
+  BOOST_REQUIRE_EQUAL(registered.size(), 4);
+  BOOST_CHECK_EQUAL(registered[0], "/ndn/neighborA");
+  BOOST_CHECK_EQUAL(registered[1], "/ndn/neighborC");
+  BOOST_CHECK_EQUAL(registered[2], conf.getLsaPrefix());
+  BOOST_CHECK_EQUAL(registered[3], conf.getLsaPrefix());
+}
+
+BOOST_AUTO_TEST_CASE(StrategyForCerts)
+{
+  this->advanceClocks(10_ms);
+  m_face.sentInterests.clear();
+
+  nlsr.registerStrategyForCerts("/ndn/site1/%C1.Router/router1");
+  nlsr.registerStrategyForCerts("/ndn/site1/%C1.Router/router2");
+  nlsr.registerStrategyForCerts("/ndn/site1/%C1.Router/router1");
+  nlsr.registerStrategyForCerts("/ndn/site2/%C1.Router/router3");
+  this->advanceClocks(10_ms);
+
+  std::set<ndn::Name> prefixes;
+  size_t nCommands = 0;
+  for (const auto& interest : m_face.sentInterests) {
+    if (ndn::Name("/localhost/nfd/strategy-choice/set").isPrefixOf(interest.getName())) {
+      ndn::nfd::ControlParameters params(interest.getName().get(4).blockFromValue());
+      prefixes.insert(params.getName());
+      ++nCommands;
+    }
+  }
+
+  // The two KEY prefixes of each router, and one site KEY prefix and operator prefix per site
+  std::set<ndn::Name> expected{"/ndn/site1/%C1.Router/router1/KEY",
+                               "/ndn/site1/%C1.Router/router1/nlsr/KEY",
+                               "/ndn/site1/%C1.Router/router2/KEY",
+                               "/ndn/site1/%C1.Router/router2/nlsr/KEY",
+                               "/ndn/site1/KEY",
+                               ndn::Name("/ndn/site1").append("%C1.Operator"),
+                               "/ndn/site2/%C1.Router/router3/KEY",
+                               "/ndn/site2/%C1.Router/router3/nlsr/KEY",
+                               "/ndn/site2/KEY",
+                               ndn::Name("/ndn/site2").append("%C1.Operator")};
+  BOOST_CHECK_EQUAL(nCommands, expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(prefixes.begin(), prefixes.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_CASE(UnconfiguredNeighbor)
 {
   Adjacent neighborA("/ndn/neighborA", ndn::FaceUri("udp4://192.168.0.100:6363"), 25, Adjacent::STATUS_INACTIVE, 0, 0);
@@ -23,6 +23,7 @@
 #include "test-common.hpp"
 
 #include <boost/filesystem.hpp>
+#include <cstddef>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -32,17 +33,21 @@ using namespace ndn;
 namespace nlsr {
 namespace test {
 
-class SequencingManagerFixture : public BaseFixture
+class SequencingManagerFixture : public UnitTestTimeFixture
 {
 public:
   SequencingManagerFixture()
-  : m_seqManager("/tmp", HYPERBOLIC_STATE_OFF)
+    : stateDir(boost::filesystem::temp_directory_path() /
+               boost::filesystem::unique_path("nlsr-seq-%%%%%%%%"))
+    , seqFile((stateDir / "nlsrSeqNo.txt").string())
+    , journalFile((stateDir / "nlsrSeqNo.journal").string())
   {
+    boost::filesystem::create_directories(stateDir);
   }
 
   ~SequencingManagerFixture()
   {
-    boost::filesystem::remove(seqFile);
+    boost::filesystem::remove_all(stateDir);
   }
 
   void
@@ -54,41 +59,47 @@ public:
   }
 
   void
-  initiateFromFile()
+  restart(int hyperbolicState = HYPERBOLIC_STATE_OFF)
   {
-    m_seqManager.initiateSeqNoFromFile();
+    m_seqManager.reset();
+    m_seqManager = std::make_unique<SequencingManager>(m_scheduler, stateDir.string(),
+                                                       hyperbolicState, MIDST_STATE_OFF);
   }
 
   void
   checkSeqNumbers(const uint64_t& name, const uint64_t& adj, const uint64_t& cor)
   {
-    BOOST_CHECK_EQUAL(m_seqManager.getNameLsaSeq(), name);
-    BOOST_CHECK_EQUAL(m_seqManager.getAdjLsaSeq(), adj);
-    BOOST_CHECK_EQUAL(m_seqManager.getCorLsaSeq(), cor);
+    BOOST_CHECK_EQUAL(m_seqManager->getNameLsaSeq(), name);
+    BOOST_CHECK_EQUAL(m_seqManager->getAdjLsaSeq(), adj);
+    BOOST_CHECK_EQUAL(m_seqManager->getCorLsaSeq(), cor);
   }
 
 public:
-  std::string seqFile = "/tmp/nlsrSeqNo.txt";
-  SequencingManager m_seqManager;
+  boost::filesystem::path stateDir;
+  std::string seqFile;
+  std::string journalFile;
+  std::unique_ptr<SequencingManager> m_seqManager;
 };
 
 BOOST_FIXTURE_TEST_SUITE(TestSequencingManager, SequencingManagerFixture)
 
 BOOST_AUTO_TEST_CASE(SeparateSeqNumber)
 {
-  initiateFromFile();
+  restart();
   checkSeqNumbers(0, 0, 0);
+  m_seqManager.reset();
+  boost::filesystem::remove(journalFile);
 
   // LS
   writeToFile("NameLsaSeq 100\nAdjLsaSeq 100\nCorLsaSeq 0");
-  m_seqManager.m_hyperbolicState = HYPERBOLIC_STATE_OFF;
-  initiateFromFile();
+  restart(HYPERBOLIC_STATE_OFF);
   checkSeqNumbers(100 + 10, 100 + 10, 0);
+  m_seqManager.reset();
+  boost::filesystem::remove(journalFile);
 
   // HR
   writeToFile("NameLsa 100\nAdjLsa 0\nCorLsa 100");
-  m_seqManager.m_hyperbolicState = HYPERBOLIC_STATE_ON;
-  initiateFromFile();
+  restart(HYPERBOLIC_STATE_ON);
   // AdjLsa is set to 0 since HR is on
   checkSeqNumbers(100 + 10, 0, 100 + 10);
 }
@@ -96,10 +107,100 @@ BOOST_AUTO_TEST_CASE(SeparateSeqNumber)
 BOOST_AUTO_TEST_CASE(CorruptFile)
 {
   writeToFile("NameLsaSeq");
-  initiateFromFile();
+  restart();
   checkSeqNumbers(10, 10, 0);
 }
 
+BOOST_AUTO_TEST_CASE(LegacyMigration)
+{
+  writeToFile("NameLsaSeq 100\nAdjLsaSeq 200\nCorLsaSeq 0\nMidstLsaSeq 0");
+  restart();
+  checkSeqNumbers(110, 210, 0);
+  BOOST_CHECK(!boost::filesystem::exists(seqFile));
+  BOOST_CHECK(boost::filesystem::exists(journalFile));
+
+  // Only the migration skips ahead
+  restart();
+  checkSeqNumbers(110, 210, 0);
+}
+
+BOOST_AUTO_TEST_CASE(JournalUnavailable)
+{
+  // A directory in place of the journal cannot be opened
+  boost::filesystem::create_directories(journalFile);
+  writeToFile("NameLsaSeq 100\nAdjLsaSeq 200\nCorLsaSeq 0\nMidstLsaSeq 0");
+  restart();
+  checkSeqNumbers(100 + 10, 200 + 10, 0);
+
+  // The text file is written instead, and skipped ahead on the next start
+  m_seqManager->increaseNameLsaSeq();
+  m_seqManager->writeSeqNoToFile();
+  restart();
+  checkSeqNumbers(111 + 10, 210 + 10, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ExactRecovery)
+{
+  restart();
+  m_seqManager->increaseNameLsaSeq();
+  m_seqManager->increaseAdjLsaSeq();
+  m_seqManager->increaseAdjLsaSeq();
+  m_seqManager->writeSeqNoToFile();
+  m_seqManager->increaseAdjLsaSeq();
+  m_seqManager->writeSeqNoToFile();
+
+  restart();
+  checkSeqNumbers(1, 3, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DeferredSync)
+{
+  restart();
+  advanceClocks(ndn::time::seconds(2));
+
+  // The first write is flushed right away, the ones after it within the interval
+  m_seqManager->increaseAdjLsaSeq();
+  m_seqManager->writeSeqNoToFile();
+  BOOST_CHECK(!m_seqManager->m_isSyncScheduled);
+  m_seqManager->increaseAdjLsaSeq();
+  m_seqManager->writeSeqNoToFile();
+  BOOST_CHECK(m_seqManager->m_isSyncScheduled);
+  m_seqManager->increaseAdjLsaSeq();
+  m_seqManager->writeSeqNoToFile();
+
+  // The last write of the burst is flushed without another write coming
+  advanceClocks(ndn::time::milliseconds(100), 10);
+  BOOST_CHECK(!m_seqManager->m_isSyncScheduled);
+  BOOST_CHECK_EQUAL(m_seqManager->m_lastSyncTime, ndn::time::steady_clock::now());
+}
+
+BOOST_AUTO_TEST_CASE(TornRecord)
+{
+  restart();
+  m_seqManager->setAdjLsaSeq(5);
+  m_seqManager->writeSeqNoToFile();
+  m_seqManager->setAdjLsaSeq(6);
+  m_seqManager->writeSeqNoToFile();
+  m_seqManager.reset();
+
+  // Corrupt the checksum of the newer record (generation 2, kept in records[0]),
+  // as if NLSR stopped in the middle of writing it
+  using Journal = SequencingManager::Journal;
+  std::fstream journal(journalFile, std::ios::in | std::ios::out | std::ios::binary);
+  journal.seekp(offsetof(Journal, records) + offsetof(SequencingManager::JournalRecord, checksum));
+  journal.put('\xff');
+  journal.close();
+
+  restart();
+  checkSeqNumbers(0, 5, 0);
+
+  // The next write replaces the corrupted record
+  m_seqManager->setAdjLsaSeq(7);
+  m_seqManager->writeSeqNoToFile();
+  restart();
+  checkSeqNumbers(0, 7, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utility/exponential-throttle.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nlsr {
+namespace util {
+namespace test {
+
+BOOST_FIXTURE_TEST_SUITE(TestExponentialThrottle, nlsr::test::UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(BackoffAndDecay)
+{
+  ExponentialThrottle throttle(1_s, 2_s, 8_s);
+  BOOST_CHECK_EQUAL(throttle.getCurrentHoldTime(), 0_ms);
+
+  // An isolated request only waits for the initial delay
+  BOOST_CHECK_EQUAL(throttle.next(), 1_s);
+  BOOST_CHECK_EQUAL(throttle.getCurrentHoldTime(), 2_s);
+  advanceClocks(1_s);
+
+  // Requests right after a run back off exponentially, up to the maximum
+  BOOST_CHECK_EQUAL(throttle.next(), 2_s);
+  advanceClocks(2_s);
+  BOOST_CHECK_EQUAL(throttle.next(), 4_s);
+  advanceClocks(4_s);
+  BOOST_CHECK_EQUAL(throttle.next(), 8_s);
+  advanceClocks(8_s);
+  BOOST_CHECK_EQUAL(throttle.next(), 8_s);
+  BOOST_CHECK_EQUAL(throttle.getNBackoffs(), 4);
+  advanceClocks(8_s);
+
+  // After a quiet period, the throttle is idle again
+  advanceClocks(1_s, 100);
+  BOOST_CHECK_EQUAL(throttle.next(), 1_s);
+  BOOST_CHECK_EQUAL(throttle.getCurrentHoldTime(), 2_s);
+  BOOST_CHECK_EQUAL(throttle.getNBackoffs(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(PartialDecay)
+{
+  ExponentialThrottle throttle(0_s, 1_s, 16_s);
+
+  BOOST_CHECK_EQUAL(throttle.next(), 0_s);
+  BOOST_CHECK_EQUAL(throttle.next(), 1_s);
+  advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(throttle.next(), 2_s);
+  advanceClocks(2_s);
+  BOOST_CHECK_EQUAL(throttle.getCurrentHoldTime(), 4_s);
+
+  // One quiet hold time halves the hold time instead of resetting it
+  advanceClocks(4_s);
+  BOOST_CHECK_EQUAL(throttle.next(), 0_s);
+  BOOST_CHECK_EQUAL(throttle.getCurrentHoldTime(), 4_s);
+  BOOST_CHECK_EQUAL(throttle.next(), 4_s);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace util
+} // namespace nlsr
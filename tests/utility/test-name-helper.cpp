@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utility/name-helper.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr {
+namespace util {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestNameHelper)
+
+BOOST_AUTO_TEST_CASE(ComponentPosition)
+{
+  ndn::Name name("/localhop/ndn/nlsr/LSA/site/%C1.Router/router");
+
+  BOOST_CHECK_EQUAL(getNameComponentPosition(name, ndn::name::Component("LSA")), 3);
+  BOOST_CHECK_EQUAL(getNameComponentPosition(name, "nlsr"), 2);
+  BOOST_CHECK_EQUAL(getNameComponentPosition(name, "INFO"), -1);
+}
+
+BOOST_AUTO_TEST_CASE(LsaNameLayoutParse)
+{
+  LsaNameLayout layout("/localhop/ndn/nlsr/LSA", "/ndn");
+  ndn::Name router("/ndn/site/%C1.Router/router");
+
+  // /<lsa-prefix>/<router>/<type>/<seq>
+  ndn::Name lsaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/router/NAME");
+  lsaName.appendNumber(7);
+
+  BOOST_CHECK(layout.matches(lsaName, 1));
+  BOOST_CHECK_EQUAL(layout.getTypeComponent(lsaName, 1), ndn::name::Component("NAME"));
+  BOOST_CHECK_EQUAL(layout.getOriginRouter(lsaName, 1), router);
+  BOOST_CHECK(layout.isFromRouter(lsaName, 1, router));
+  BOOST_CHECK(!layout.isFromRouter(lsaName, 1, "/ndn/site/%C1.Router/other-router"));
+  BOOST_CHECK(!layout.isFromRouter(lsaName, 1, "/ndn/site/%C1.Router/router/extra"));
+  BOOST_CHECK(!layout.isFromRouter(lsaName, 1, "/other/site/%C1.Router/router"));
+
+  // The same LSA name as carried in sync updates, without a sequence number
+  ndn::Name updateName = lsaName.getPrefix(-1);
+  BOOST_CHECK(layout.matches(updateName, 0));
+  BOOST_CHECK_EQUAL(layout.getTypeComponent(updateName, 0), ndn::name::Component("NAME"));
+  BOOST_CHECK_EQUAL(layout.getOriginRouter(updateName, 0), router);
+
+  // Segmented LSA data names carry a version and a segment number as well
+  ndn::Name segmentName(lsaName);
+  segmentName.appendVersion(1).appendSegment(0);
+  BOOST_CHECK(layout.matches(segmentName, 3));
+  BOOST_CHECK(layout.isFromRouter(segmentName, 3, router));
+
+  BOOST_CHECK(!layout.matches("/localhop/ndn/nlsr/LSA/NAME", 0));
+  BOOST_CHECK(!layout.matches("/site/%C1.Router/router/NAME", 0));
+  BOOST_CHECK(!layout.matches("/localhop/other/nlsr/LSA/site/%C1.Router/router/NAME", 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace util
+} // namespace nlsr